@@ -0,0 +1,29 @@
+// apps/log_decode.cpp
+//
+// Renders a binary deferred log (DeferredLogOptions::binary_path) as text,
+// one line per record, to stdout.
+#include <seedlib/deferred_log.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+int main(int argc, char** argv) {
+    if (argc != 2 || std::string_view(argv[1]) == "--help") {
+        std::fprintf(argc == 2 ? stdout : stderr, "usage: log_decode FILE\n");
+        return argc == 2 ? 0 : 2;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "log_decode: cannot open %s\n", argv[1]);
+        return 1;
+    }
+    if (!seedlib::decode_deferred_log(in, std::cout)) {
+        std::cout.flush();
+        std::fprintf(stderr, "log_decode: %s is truncated or not a deferred log\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -1 +1,389 @@
-// TODO: Command-line interface
+// apps/url_cli.cpp
+//
+// Extracts URL components from line-oriented input (one URL per line, or
+// with --extract the first "scheme://" token of each log line) and writes
+// them as TSV or JSON lines. Files are memory-mapped; stdin is read in
+// large chunks. Lines are parsed in windows with the batch API across
+// worker threads, each worker formats its own contiguous slice of the
+// window, and the slices are written in input order.
+#include <seedlib/url_batch.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace seedlib;
+
+namespace {
+    enum class Field { url, scheme, host, port, path, query, fragment };
+    enum class Format { tsv, json };
+
+    struct Options {
+        std::vector<Field> fields{Field::host, Field::path};
+        Format format{Format::tsv};
+        unsigned threads{std::max(1u, std::thread::hardware_concurrency())};
+        bool extract{false};
+        bool errors{false};
+        const char* input{nullptr};  // nullptr or "-" for stdin
+    };
+
+    constexpr size_t kWindowLines = 1 << 16;
+    constexpr size_t kReadChunk = 8 << 20;
+
+    void usage(FILE* out) {
+        std::fputs(
+            "usage: url_cli [options] [FILE]\n"
+            "  -f, --fields LIST    comma-separated: url,scheme,host,port,path,query,fragment\n"
+            "                       (default host,path)\n"
+            "  -o, --format FORMAT  tsv (default) or json, one object per line\n"
+            "  -j, --threads N      worker threads (default: all cores)\n"
+            "  -x, --extract        take the first scheme:// token of each line\n"
+            "  -e, --errors         also report invalid lines, with line number and reason\n"
+            "  -h, --help\n"
+            "Reads stdin when FILE is missing or \"-\".\n",
+            out);
+    }
+
+    const char* field_name(Field field) {
+        switch (field) {
+        case Field::url: return "url";
+        case Field::scheme: return "scheme";
+        case Field::host: return "host";
+        case Field::port: return "port";
+        case Field::path: return "path";
+        case Field::query: return "query";
+        case Field::fragment: return "fragment";
+        }
+        return "";
+    }
+
+    bool parse_fields(std::string_view list, std::vector<Field>& fields) {
+        fields.clear();
+        while (!list.empty()) {
+            const size_t comma = list.find(',');
+            const std::string_view name = list.substr(0, comma);
+            bool known = false;
+            for (Field field : {Field::url, Field::scheme, Field::host, Field::port, Field::path,
+                                Field::query, Field::fragment}) {
+                if (name == field_name(field)) {
+                    fields.push_back(field);
+                    known = true;
+                }
+            }
+            if (!known) return false;
+            list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+        }
+        return !fields.empty();
+    }
+
+    bool parse_options(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+
+            if (arg == "-h" || arg == "--help") {
+                usage(stdout);
+                std::exit(0);
+            } else if (arg == "-f" || arg == "--fields") {
+                const char* list = value();
+                if (!list || !parse_fields(list, options.fields)) return false;
+            } else if (arg == "-o" || arg == "--format") {
+                const char* format = value();
+                if (!format) return false;
+                if (std::string_view(format) == "tsv") {
+                    options.format = Format::tsv;
+                } else if (std::string_view(format) == "json") {
+                    options.format = Format::json;
+                } else {
+                    return false;
+                }
+            } else if (arg == "-j" || arg == "--threads") {
+                const char* count = value();
+                if (!count || std::atoi(count) < 1) return false;
+                options.threads = static_cast<unsigned>(std::atoi(count));
+            } else if (arg == "-x" || arg == "--extract") {
+                options.extract = true;
+            } else if (arg == "-e" || arg == "--errors") {
+                options.errors = true;
+            } else if (arg.size() > 1 && arg[0] == '-' && arg != "-") {
+                return false;
+            } else if (!options.input) {
+                options.input = argv[i];
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // First whitespace-delimited token containing "://", without the
+    // quotes log formats put around referers
+    std::string_view extract_url(std::string_view line) {
+        const size_t marker = line.find("://");
+        if (marker == std::string_view::npos) return {};
+        size_t begin = marker;
+        while (begin > 0 && line[begin - 1] != ' ' && line[begin - 1] != '\t' && line[begin - 1] != '"') --begin;
+        size_t end = marker;
+        while (end < line.size() && line[end] != ' ' && line[end] != '\t' && line[end] != '"') ++end;
+        return line.substr(begin, end - begin);
+    }
+
+    std::string_view trim(std::string_view line) {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) {
+            line.remove_suffix(1);
+        }
+        while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) line.remove_prefix(1);
+        return line;
+    }
+
+    void append_json_string(std::string& out, std::string_view text) {
+        static constexpr char hex[] = "0123456789abcdef";
+        out += '"';
+        size_t run = 0;  // Start of the pending run that needs no escaping
+        for (size_t i = 0; i < text.size(); ++i) {
+            const auto byte = static_cast<unsigned char>(text[i]);
+            if (byte >= 0x20 && byte != '"' && byte != '\\') continue;
+            out.append(text.data() + run, i - run);
+            run = i + 1;
+            if (byte < 0x20) {
+                out += "\\u00";
+                out += hex[byte >> 4];
+                out += hex[byte & 0xF];
+            } else {
+                out += '\\';
+                out += static_cast<char>(byte);
+            }
+        }
+        out.append(text.data() + run, text.size() - run);
+        out += '"';
+    }
+
+    // Lines are split with memchr, which libc vectorizes, and parsed and
+    // formatted a window at a time
+    class Pipeline {
+    public:
+        explicit Pipeline(const Options& options) : options_(options), outputs_(options.threads) {}
+
+        // Consumes complete lines from [first, last); with final set, a
+        // trailing line without a newline as well. Returns the bytes used.
+        // Everything consumed is written out before returning, so the
+        // caller may reuse the buffer.
+        size_t consume(const char* first, const char* last, bool final) {
+            const char* p = first;
+            while (p != last) {
+                const void* newline = std::memchr(p, '\n', static_cast<size_t>(last - p));
+                if (!newline && !final) break;
+                const char* line_end = newline ? static_cast<const char*>(newline) : last;
+                add_line(std::string_view(p, static_cast<size_t>(line_end - p)));
+                p = newline ? line_end + 1 : last;
+                if (lines_.size() == kWindowLines) flush();
+            }
+            flush();
+            return static_cast<size_t>(p - first);
+        }
+
+        uint64_t invalid() const { return invalid_; }
+
+    private:
+        void add_line(std::string_view line) {
+            ++line_number_;
+            line = trim(line);
+            if (options_.extract) line = extract_url(line);
+            if (line.empty()) return;
+            lines_.push_back(line);
+            line_numbers_.push_back(line_number_);
+        }
+
+        void flush() {
+            if (lines_.empty()) return;
+            parse_batch(lines_, batch_, options_.threads);
+
+            // Contiguous slices keep output in input order with no locking
+            const size_t workers = std::min<size_t>(options_.threads, (lines_.size() + 1023) / 1024);
+            const size_t per_worker = (lines_.size() + workers - 1) / workers;
+            std::vector<std::thread> threads;
+            for (size_t w = 1; w < workers; ++w) {
+                threads.emplace_back([this, w, per_worker] { format(w, w * per_worker, per_worker); });
+            }
+            format(0, 0, per_worker);
+            for (auto& thread : threads) thread.join();
+
+            for (size_t w = 0; w < workers; ++w) {
+                std::fwrite(outputs_[w].data(), 1, outputs_[w].size(), stdout);
+            }
+            invalid_ += lines_.size() - batch_.valid_count();
+            lines_.clear();
+            line_numbers_.clear();
+        }
+
+        void format(size_t worker, size_t begin, size_t count) {
+            std::string& out = outputs_[worker];
+            out.clear();
+            const size_t end = std::min(lines_.size(), begin + count);
+            for (size_t i = begin; i < end; ++i) {
+                if (!batch_.valid(i)) {
+                    if (options_.errors) format_error(out, i);
+                    continue;
+                }
+                options_.format == Format::json ? format_json(out, i) : format_tsv(out, i);
+            }
+        }
+
+        std::string_view component(const URLView& view, size_t i, Field field,
+                                   char (&port_buffer)[8]) const {
+            switch (field) {
+            case Field::url: return lines_[i];
+            case Field::scheme:
+                return view.scheme_id() != SchemeId::unknown ? scheme_info(view.scheme_id()).name
+                                                             : view.scheme();
+            case Field::host: return view.host();
+            case Field::port: {
+                if (view.port() == 0) return {};
+                const int n = std::snprintf(port_buffer, sizeof(port_buffer), "%u", view.port());
+                return {port_buffer, static_cast<size_t>(n)};
+            }
+            case Field::path: return view.path();
+            case Field::query: return view.query();
+            case Field::fragment: return view.fragment();
+            }
+            return {};
+        }
+
+        void format_tsv(std::string& out, size_t i) const {
+            const URLView view = batch_.view(i);
+            char port_buffer[8];
+            for (size_t f = 0; f < options_.fields.size(); ++f) {
+                if (f != 0) out += '\t';
+                out += component(view, i, options_.fields[f], port_buffer);
+            }
+            out += '\n';
+        }
+
+        void format_json(std::string& out, size_t i) const {
+            const URLView view = batch_.view(i);
+            char port_buffer[8];
+            out += '{';
+            for (size_t f = 0; f < options_.fields.size(); ++f) {
+                const Field field = options_.fields[f];
+                if (f != 0) out += ',';
+                out += '"';
+                out += field_name(field);
+                out += "\":";
+                const std::string_view value = component(view, i, field, port_buffer);
+                if (field == Field::port) {
+                    out += value.empty() ? std::string_view("null") : value;
+                } else {
+                    append_json_string(out, value);
+                }
+            }
+            out += "}\n";
+        }
+
+        void format_error(std::string& out, size_t i) const {
+            URLError error{batch_.error(i), 0};
+            const std::string line_number = std::to_string(line_numbers_[i]);
+            if (options_.format == Format::json) {
+                out += "{\"line\":";
+                out += line_number;
+                out += ",\"error\":";
+                append_json_string(out, error.message());
+                out += ",\"input\":";
+                append_json_string(out, lines_[i]);
+                out += "}\n";
+            } else {
+                out += "#error\t";
+                out += line_number;
+                out += '\t';
+                out += error.message();
+                out += '\n';
+            }
+        }
+
+        const Options& options_;
+        std::vector<std::string_view> lines_;
+        std::vector<uint64_t> line_numbers_;
+        std::vector<std::string> outputs_;
+        URLBatch batch_;
+        uint64_t line_number_{0};
+        uint64_t invalid_{0};
+    };
+
+    // Whole-file mapping; false (with errno set) if the file can't be mapped
+    bool run_mapped(int fd, Pipeline& pipeline) {
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) return false;
+        if (info.st_size == 0) return true;
+
+        const auto size = static_cast<size_t>(info.st_size);
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) return false;
+        madvise(data, size, MADV_SEQUENTIAL);
+
+        const char* begin = static_cast<const char*>(data);
+        pipeline.consume(begin, begin + size, true);
+        munmap(data, size);
+        return true;
+    }
+
+    // Chunked reads for pipes; a partial last line moves to the front
+    bool run_streamed(int fd, Pipeline& pipeline) {
+        std::vector<char> buffer(kReadChunk);
+        size_t filled = 0;
+        for (;;) {
+            if (filled == buffer.size()) buffer.resize(buffer.size() * 2);  // Very long line
+            const ssize_t n = read(fd, buffer.data() + filled, buffer.size() - filled);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            filled += static_cast<size_t>(n);
+
+            const bool final = n == 0;
+            const size_t used = pipeline.consume(buffer.data(), buffer.data() + filled, final);
+            std::memmove(buffer.data(), buffer.data() + used, filled - used);
+            filled -= used;
+            if (final) return true;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        usage(stderr);
+        return 2;
+    }
+
+    const bool from_stdin = !options.input || std::string_view(options.input) == "-";
+    const int fd = from_stdin ? STDIN_FILENO : open(options.input, O_RDONLY);
+    if (fd < 0) {
+        std::fprintf(stderr, "url_cli: %s: %s\n", options.input, std::strerror(errno));
+        return 1;
+    }
+
+    Pipeline pipeline(options);
+    const bool ok = run_mapped(fd, pipeline) || run_streamed(fd, pipeline);
+    if (!from_stdin) close(fd);
+    if (!ok) {
+        std::fprintf(stderr, "url_cli: read failed: %s\n", std::strerror(errno));
+        return 1;
+    }
+
+    std::fflush(stdout);
+    if (pipeline.invalid() != 0 && !options.errors) {
+        std::fprintf(stderr, "url_cli: skipped %llu invalid lines\n",
+                     static_cast<unsigned long long>(pipeline.invalid()));
+    }
+    return 0;
+}
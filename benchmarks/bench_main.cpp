@@ -0,0 +1,252 @@
+// benchmarks/bench_main.cpp
+//
+// Benchmark entry point with some additions to the usual flags:
+//
+//   --baseline=FILE        fail (exit 1) if any benchmark in FILE is more
+//                          than --tolerance slower than recorded there
+//   --tolerance=FRACTION   allowed slowdown, default 0.25
+//   --reference=NAME       compare times as ratios to benchmark NAME from
+//                          the same run rather than as absolute times
+//   --write-baseline=FILE  record this run's CPU times as the new baseline
+//
+// Baselines are flat JSON objects of benchmark name to CPU nanoseconds per
+// iteration, taken as the fastest of the --benchmark_repetitions runs:
+// noise only ever adds time, so the minimum moves far less between runs
+// than a median does. Benchmarks missing from the baseline, or filtered
+// out of the run, are not compared.
+//
+// A baseline belongs to the host it was recorded on. Re-record it there
+// with the benchmark_baseline target before running benchmark_gate on a
+// new machine; --reference only absorbs a uniform change in speed.
+#include "bench_support.hpp"
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    std::atomic<uint64_t> allocations{0};
+}
+
+uint64_t seedlib::bench::allocation_count() noexcept {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+// Counting allocator hook. The array forms route through the plain ones,
+// but libstdc++'s aligned forms call aligned_alloc directly, so
+// over-aligned types (metrics blocks, cache and interner shards) are
+// counted by the align_val_t overloads.
+namespace {
+    void* aligned_malloc(size_t size, std::align_val_t alignment) noexcept {
+        const auto align = static_cast<size_t>(alignment);
+        if (align <= alignof(std::max_align_t)) return std::malloc(size ? size : 1);
+        // aligned_alloc wants a multiple of the alignment
+        return std::aligned_alloc(align, ((size ? size : 1) + align - 1) & ~(align - 1));
+    }
+}
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = aligned_malloc(size, alignment)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return aligned_malloc(size, alignment);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+    using Timings = std::map<std::string, double>;
+
+    // Keeps each benchmark's fastest repetition, in CPU nanoseconds per
+    // iteration; aggregates are ignored
+    class RecordingReporter : public benchmark::ConsoleReporter {
+    public:
+        void ReportRuns(const std::vector<Run>& runs) override {
+            ConsoleReporter::ReportRuns(runs);
+            for (const Run& run : runs) {
+                if (run.error_occurred || run.run_type == Run::RT_Aggregate) continue;
+                const double ns = run.GetAdjustedCPUTime() * 1e9 / benchmark::GetTimeUnitMultiplier(run.time_unit);
+                auto [it, inserted] = timings.emplace(run.run_name.str(), ns);
+                if (!inserted && ns < it->second) it->second = ns;
+            }
+        }
+
+        Timings timings;
+    };
+
+    // Reads {"name": number, ...}; false if the file is not that shape
+    bool read_baseline(const std::string& path, Timings& out) {
+        std::ifstream in(path);
+        if (!in) return false;
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        const std::string text = buffer.str();
+
+        size_t i = 0;
+        auto skip_space = [&] {
+            while (i < text.size() && std::isspace(static_cast<unsigned char>(text[i]))) ++i;
+        };
+        auto expect = [&](char c) {
+            skip_space();
+            if (i < text.size() && text[i] == c) {
+                ++i;
+                return true;
+            }
+            return false;
+        };
+
+        if (!expect('{')) return false;
+        if (expect('}')) return true;
+        do {
+            if (!expect('"')) return false;
+            std::string name;
+            while (i < text.size() && text[i] != '"') {
+                if (text[i] == '\\' && i + 1 < text.size()) ++i;
+                name.push_back(text[i++]);
+            }
+            if (!expect('"') || !expect(':')) return false;
+            skip_space();
+            char* end = nullptr;
+            const double value = std::strtod(text.c_str() + i, &end);
+            if (end == text.c_str() + i) return false;
+            i = static_cast<size_t>(end - text.c_str());
+            out[name] = value;
+        } while (expect(','));
+        return expect('}');
+    }
+
+    bool write_baseline(const std::string& path, const Timings& timings) {
+        std::ofstream out(path);
+        out << "{\n";
+        size_t written = 0;
+        for (const auto& [name, ns] : timings) {
+            char value[32];
+            std::snprintf(value, sizeof(value), "%.1f", ns);
+            out << "  \"" << name << "\": " << value << (++written == timings.size() ? "\n" : ",\n");
+        }
+        out << "}\n";
+        return static_cast<bool>(out);
+    }
+
+    // With a reference, each time is first scaled by how much faster or
+    // slower the reference ran than when the baseline was recorded
+    bool within_baseline(const Timings& baseline, const Timings& current, double tolerance,
+                         const std::string& reference) {
+        double scale = 1.0;
+        if (!reference.empty()) {
+            auto recorded = baseline.find(reference);
+            auto now = current.find(reference);
+            if (recorded == baseline.end() || now == current.end()) {
+                std::fprintf(stderr, "reference %s missing from the %s\n", reference.c_str(),
+                             recorded == baseline.end() ? "baseline" : "run");
+                return false;
+            }
+            scale = now->second / recorded->second;
+            std::fprintf(stderr, "reference %s: %.2fx the baseline time\n", reference.c_str(), scale);
+        }
+
+        size_t compared = 0;
+        size_t regressions = 0;
+        for (const auto& [name, recorded] : baseline) {
+            auto it = current.find(name);
+            if (it == current.end() || name == reference) continue;
+            ++compared;
+            const double expected = recorded * scale;
+            const double ratio = it->second / expected;
+            if (ratio > 1.0 + tolerance) {
+                ++regressions;
+                std::fprintf(stderr, "REGRESSION %s: %.1f ns, baseline %.1f ns (+%.0f%%)\n", name.c_str(),
+                             it->second, expected, (ratio - 1.0) * 100.0);
+            }
+        }
+        std::fprintf(stderr, "baseline: %zu compared, %zu regressed beyond %.0f%%\n", compared, regressions,
+                     tolerance * 100.0);
+        return regressions == 0;
+    }
+
+    // Removes --name=value from argv, returning the value
+    bool take_flag(int& argc, char** argv, std::string_view name, std::string& value) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg(argv[i]);
+            if (arg.size() > name.size() + 3 && arg.substr(0, 2) == "--" && arg.substr(2, name.size()) == name &&
+                arg[name.size() + 2] == '=') {
+                value = std::string(arg.substr(name.size() + 3));
+                for (int j = i; j + 1 < argc; ++j) argv[j] = argv[j + 1];
+                --argc;
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string baseline_path;
+    std::string output_path;
+    std::string tolerance_text;
+    std::string reference;
+    take_flag(argc, argv, "baseline", baseline_path);
+    take_flag(argc, argv, "reference", reference);
+    take_flag(argc, argv, "write-baseline", output_path);
+    take_flag(argc, argv, "tolerance", tolerance_text);
+    const double tolerance = tolerance_text.empty() ? 0.25 : std::strtod(tolerance_text.c_str(), nullptr);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    Timings baseline;
+    if (!baseline_path.empty() && !read_baseline(baseline_path, baseline)) {
+        std::fprintf(stderr, "cannot read baseline %s\n", baseline_path.c_str());
+        return 1;
+    }
+
+    RecordingReporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+
+    if (!output_path.empty() && !write_baseline(output_path, reporter.timings)) {
+        std::fprintf(stderr, "cannot write baseline %s\n", output_path.c_str());
+        return 1;
+    }
+    if (!baseline_path.empty() && !within_baseline(baseline, reporter.timings, tolerance, reference)) return 1;
+    return 0;
+}
@@ -0,0 +1,35 @@
+// benchmarks/bench_support.hpp
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace seedlib::bench {
+
+// Global operator new calls so far, from every thread (see bench_main.cpp)
+uint64_t allocation_count() noexcept;
+
+// Zipf(s = 1) sample of indices in [0, distinct): a few URLs dominate, as
+// in gateway traffic. Seeded so runs are comparable.
+inline std::vector<size_t> zipf_indices(size_t distinct, size_t count, uint64_t seed = 42) {
+    std::vector<double> cdf(distinct);
+    double total = 0;
+    for (size_t rank = 0; rank < distinct; ++rank) {
+        total += 1.0 / static_cast<double>(rank + 1);
+        cdf[rank] = total;
+    }
+
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> dist(0.0, total);
+    std::vector<size_t> indices(count);
+    for (auto& index : indices) {
+        index = static_cast<size_t>(std::lower_bound(cdf.begin(), cdf.end(), dist(gen)) - cdf.begin());
+        index = std::min(index, distinct - 1);
+    }
+    return indices;
+}
+
+} // namespace seedlib::bench
@@ -0,0 +1,248 @@
+// benchmarks/corpus_benchmark.cpp
+//
+// Parse, view-parse and validation over whole corpora. Each corpus is read
+// from <corpus dir>/corpus_<name>.txt, one URL per line, where the corpus
+// dir is $SEEDLIB_CORPUS_DIR or SEEDLIB_CORPUS_DIR from the build (the
+// repository's tests/data). Corpora without a file are generated from a
+// fixed seed, so runs on any machine see the same inputs.
+#include "bench_support.hpp"
+#include <benchmark/benchmark.h>
+#include <seedlib/url.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef SEEDLIB_CORPUS_DIR
+#define SEEDLIB_CORPUS_DIR "tests/data"
+#endif
+
+using namespace seedlib;
+
+namespace {
+    struct Corpus {
+        std::vector<std::string> urls;
+        size_t bytes{0};
+        bool from_file{false};
+    };
+
+    class Generator {
+    public:
+        explicit Generator(uint64_t seed) : gen_(seed) {}
+
+        size_t below(size_t n) { return std::uniform_int_distribution<size_t>(0, n - 1)(gen_); }
+
+        template <size_t N>
+        const char* pick(const char* const (&options)[N]) {
+            return options[below(N)];
+        }
+
+        std::string token(size_t length) {
+            static constexpr char kAlphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-_";
+            std::string result(length, ' ');
+            for (char& c : result) c = kAlphabet[below(sizeof(kAlphabet) - 1)];
+            return result;
+        }
+
+        // Random bytes escaped as %XX, as a browser sends non-ASCII text
+        std::string encoded(size_t bytes) {
+            static constexpr char kHex[] = "0123456789ABCDEF";
+            std::string result;
+            for (size_t i = 0; i < bytes; ++i) {
+                const size_t byte = 0x80 + below(0x80);
+                result += '%';
+                result += kHex[byte >> 4];
+                result += kHex[byte & 15];
+            }
+            return result;
+        }
+
+    private:
+        std::mt19937_64 gen_;
+    };
+
+    const char* const kHosts[] = {"www.example.com", "shop.example.co.uk", "api.service.internal",
+                                  "cdn-edge-17.assets.example.net", "xn--bcher-kva.example", "m.example.org"};
+    const char* const kPaths[] = {"/", "/index.html", "/api/v2/users/8812/orders", "/static/js/app.4f9a1c.js",
+                                  "/products/outdoor/tents/ultralight-2p", "/search"};
+
+    // Ad and newsletter links: long paths and a dozen tracking parameters
+    std::vector<std::string> generate_tracking(size_t count) {
+        Generator gen(101);
+        const char* const sources[] = {"newsletter", "google", "facebook", "partner_feed", "affiliate"};
+        std::vector<std::string> urls;
+        for (size_t i = 0; i < count; ++i) {
+            std::string url = std::string("https://") + gen.pick(kHosts) + gen.pick(kPaths);
+            url += "?utm_source=" + std::string(gen.pick(sources)) + "&utm_medium=email&utm_campaign=spring_sale_" +
+                   std::to_string(2020 + gen.below(6)) + "&utm_content=" + gen.token(12) +
+                   "&utm_term=" + gen.token(8) + "&gclid=" + gen.token(40) + "&fbclid=" + gen.token(60) +
+                   "&mc_eid=" + gen.token(10) + "&ref=" + gen.token(16);
+            if (gen.below(3) == 0) url += "#section-" + std::to_string(gen.below(10));
+            urls.push_back(std::move(url));
+        }
+        return urls;
+    }
+
+    // Search and API URLs whose queries are mostly escapes
+    std::vector<std::string> generate_encoded(size_t count) {
+        Generator gen(202);
+        std::vector<std::string> urls;
+        for (size_t i = 0; i < count; ++i) {
+            std::string url = std::string("https://") + gen.pick(kHosts) + "/search/" + gen.encoded(6);
+            url += "?q=" + gen.encoded(4 + gen.below(24)) + "+" + gen.encoded(4 + gen.below(12));
+            url += "&filters=%7B%22price%22%3A%5B" + std::to_string(gen.below(100)) + "%2C" +
+                   std::to_string(100 + gen.below(900)) + "%5D%2C%22tags%22%3A%5B%22" + gen.token(6) + "%22%5D%7D";
+            url += "&redirect=https%3A%2F%2F" + std::string(gen.pick(kHosts)) + "%2Fcallback%3Fsession%3D" +
+                   gen.token(24);
+            urls.push_back(std::move(url));
+        }
+        return urls;
+    }
+
+    // What a public endpoint sees besides clean URLs
+    std::vector<std::string> generate_malformed(size_t count) {
+        Generator gen(303);
+        std::vector<std::string> urls;
+        for (size_t i = 0; i < count; ++i) {
+            const std::string host = gen.pick(kHosts);
+            const std::string path = gen.pick(kPaths);
+            switch (gen.below(10)) {
+            case 0: urls.push_back(host + path); break;  // No scheme
+            case 1: urls.push_back("http://" + host + ":" + std::to_string(65536 + gen.below(9000)) + path); break;
+            case 2: urls.push_back("http://[2001:db8::" + std::to_string(gen.below(100)) + path); break;
+            case 3: urls.push_back("ht tp://" + host + path); break;
+            case 4: urls.push_back("http://" + host + ":80a" + path); break;
+            case 5: urls.push_back("://" + host + path); break;
+            case 6: urls.push_back("http://" + host + path + "?q=" + gen.token(8) + "%zz%4"); break;
+            case 7: urls.push_back("http://" + host + "\\" + gen.token(6) + " " + gen.token(4)); break;
+            case 8: urls.push_back("1http://" + host + path); break;
+            default: urls.push_back("https://" + host + path + "?id=" + gen.token(10)); break;  // Valid
+            }
+        }
+        return urls;
+    }
+
+    // IPv4, IPv6, userinfo, ports and fragments across schemes
+    std::vector<std::string> generate_mixed(size_t count) {
+        Generator gen(404);
+        const char* const schemes[] = {"http", "https", "ws", "wss", "ftp"};
+        std::vector<std::string> urls;
+        for (size_t i = 0; i < count; ++i) {
+            std::string url = std::string(gen.pick(schemes)) + "://";
+            switch (gen.below(5)) {
+            case 0:
+                url += "[2001:db8:" + std::to_string(gen.below(9999)) + "::" + std::to_string(gen.below(99)) + "]";
+                break;
+            case 1:
+                url += "10." + std::to_string(gen.below(256)) + "." + std::to_string(gen.below(256)) + ".1";
+                break;
+            case 2:
+                url += "user" + std::to_string(gen.below(100)) + ":" + gen.token(10) + "@" + gen.pick(kHosts);
+                break;
+            default:
+                url += gen.pick(kHosts);
+                break;
+            }
+            if (gen.below(2) == 0) url += ":" + std::to_string(1 + gen.below(65535));
+            url += gen.pick(kPaths);
+            if (gen.below(2) == 0) url += "?page=" + std::to_string(gen.below(50)) + "&sort=" + gen.token(5);
+            if (gen.below(4) == 0) url += "#" + gen.token(8);
+            urls.push_back(std::move(url));
+        }
+        return urls;
+    }
+
+    // Repeats of the mixed corpus with Zipf-skewed frequency
+    std::vector<std::string> generate_zipf(const std::vector<std::string>& distinct) {
+        std::vector<std::string> urls;
+        for (size_t index : bench::zipf_indices(distinct.size(), 1 << 16, 505)) urls.push_back(distinct[index]);
+        return urls;
+    }
+
+    bool read_lines(const std::string& path, std::vector<std::string>& urls) {
+        std::ifstream in(path);
+        if (!in) return false;
+        for (std::string line; std::getline(in, line);) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (!line.empty()) urls.push_back(std::move(line));
+        }
+        return !urls.empty();
+    }
+
+    const Corpus& corpus(const std::string& name) {
+        static std::map<std::string, Corpus> loaded;
+        auto it = loaded.find(name);
+        if (it != loaded.end()) return it->second;
+
+        const char* dir = std::getenv("SEEDLIB_CORPUS_DIR");
+        Corpus result;
+        result.from_file = read_lines(std::string(dir ? dir : SEEDLIB_CORPUS_DIR) + "/corpus_" + name + ".txt",
+                                      result.urls);
+        if (!result.from_file) {
+            result.urls.clear();
+            if (name == "tracking") result.urls = generate_tracking(2000);
+            else if (name == "encoded") result.urls = generate_encoded(2000);
+            else if (name == "malformed") result.urls = generate_malformed(2000);
+            else if (name == "mixed") result.urls = generate_mixed(10000);
+            else if (name == "zipf") result.urls = generate_zipf(corpus("mixed").urls);
+        }
+        for (const auto& url : result.urls) result.bytes += url.size();
+        return loaded.emplace(name, std::move(result)).first->second;
+    }
+
+    constexpr const char* kCorpora[] = {"tracking", "encoded", "malformed", "mixed", "zipf"};
+
+    // Runs body over every URL of the corpus per iteration and reports
+    // throughput, allocations per URL and the share that were valid
+    template <typename Body>
+    void run_corpus(benchmark::State& state, const std::string& name, Body body) {
+        const Corpus& input = corpus(name);
+        state.SetLabel(input.from_file ? "file" : "generated");
+        size_t valid = 0;
+        const uint64_t allocations = bench::allocation_count();
+
+        for (auto _ : state) {
+            valid = 0;
+            for (const auto& url : input.urls) valid += body(url) ? 1 : 0;
+            benchmark::DoNotOptimize(valid);
+        }
+
+        const auto processed = state.iterations() * static_cast<int64_t>(input.urls.size());
+        state.SetItemsProcessed(processed);
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.bytes));
+        const uint64_t allocated = bench::allocation_count() - allocations;
+        state.counters["allocs_per_url"] =
+            static_cast<double>(allocated) / static_cast<double>(std::max<int64_t>(1, processed));
+        state.counters["valid"] =
+            static_cast<double>(valid) / static_cast<double>(std::max<size_t>(1, input.urls.size()));
+    }
+
+    template <typename Body>
+    void register_corpus(const char* prefix, const std::string& name, Body body) {
+        benchmark::RegisterBenchmark((std::string(prefix) + "/" + name).c_str(),
+                                     [name, body](benchmark::State& state) { run_corpus(state, name, body); });
+    }
+
+    // Benchmark parse, view-only parse and validation over every corpus
+    const bool registered = [] {
+        for (const char* name : kCorpora) {
+            register_corpus("BM_CorpusParse", name, [](const std::string& url) { return URL::parse(url).has_value(); });
+            register_corpus("BM_CorpusView", name,
+                            [](const std::string& url) { return URLView::parse(url).has_value(); });
+            register_corpus("BM_CorpusCheck", name, [](const std::string& url) { return !URL::check(url); });
+        }
+        // No seedlib code: a byte-serial FNV-1a pass that the regression
+        // gate divides the others by, so that host speed cancels out
+        register_corpus("BM_CorpusReference", "mixed", [](const std::string& url) {
+            uint64_t hash = 14695981039346656037ull;
+            for (char c : url) hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+            return (hash & 1) != 0;
+        });
+        return true;
+    }();
+}
@@ -0,0 +1,106 @@
+// benchmarks/logging_benchmark.cpp
+#include <benchmark/benchmark.h>
+#include <seedlib/deferred_log.hpp>
+#include <seedlib/logging.hpp>
+#include <seedlib/metrics.hpp>
+#include <spdlog/sinks/null_sink.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+using namespace seedlib;
+
+namespace {
+    // Formatting cost only: lines go to a sink that drops them
+    void use_null_logger() {
+        auto logger = std::make_shared<spdlog::logger>("bench", std::make_shared<spdlog::sinks::null_sink_mt>());
+        logger->set_level(spdlog::level::info);
+        Logger::instance().init(logger);
+    }
+}
+
+// Benchmark one metric per request with tags in a hash map
+static void BM_LogMetricMap(benchmark::State& state) {
+    use_null_logger();
+    const std::string endpoint = "/api/v1/users";
+
+    for (auto _ : state) {
+        LOG_METRIC("request_duration_ms", 42.3,
+                   std::unordered_map<std::string, std::string>{{"endpoint", endpoint}, {"method", "GET"}});
+    }
+}
+BENCHMARK(BM_LogMetricMap);
+
+// Benchmark the same metric with string_view pairs
+static void BM_LogMetricPairs(benchmark::State& state) {
+    use_null_logger();
+    const std::string endpoint = "/api/v1/users";
+
+    for (auto _ : state) {
+        LOG_METRIC("request_duration_ms", 42.3, {{"endpoint", endpoint}, {"method", "GET"}});
+    }
+}
+BENCHMARK(BM_LogMetricPairs);
+
+// Benchmark variadic tags with a numeric value formatted in place
+static void BM_LogMetricVariadic(benchmark::State& state) {
+    use_null_logger();
+    const std::string endpoint = "/api/v1/users";
+
+    for (auto _ : state) {
+        LOG_METRIC("request_duration_ms", 42.3, "endpoint", endpoint, "status", 200);
+    }
+}
+BENCHMARK(BM_LogMetricVariadic);
+
+// Benchmark a formatted line on the calling thread, for comparison
+static void BM_LogFormatted(benchmark::State& state) {
+    use_null_logger();
+    const std::string endpoint = "/api/v1/users";
+
+    for (auto _ : state) {
+        Logger::instance().warn("request {} on {} took {}us", 17, endpoint, 42.3);
+    }
+}
+BENCHMARK(BM_LogFormatted);
+
+// Benchmark the same line captured for the background formatter
+static void BM_LogDeferred(benchmark::State& state) {
+    DeferredLogOptions options;
+    options.logger = std::make_shared<spdlog::logger>("bench_deferred", std::make_shared<spdlog::sinks::null_sink_mt>());
+    options.level = spdlog::level::info;
+    DeferredLog::instance().start(options);
+    const uint64_t dropped = DeferredLog::instance().dropped();
+    const std::string endpoint = "/api/v1/users";
+
+    for (auto _ : state) {
+        LOG_DEFERRED_WARN("request {} on {} took {}us", 17, endpoint, 42.3);
+    }
+    DeferredLog::instance().stop();
+    // With fewer cores than threads the formatter falls behind and the
+    // cheaper drop path shows up in the timing
+    state.counters["dropped"] = static_cast<double>(DeferredLog::instance().dropped() - dropped);
+}
+BENCHMARK(BM_LogDeferred);
+
+// Benchmark a registered counter, the replacement for count-style metrics
+static void BM_MetricsCounter(benchmark::State& state) {
+    const metrics::Counter requests = metrics::counter("bench_requests_total");
+
+    for (auto _ : state) {
+        requests.add();
+    }
+}
+BENCHMARK(BM_MetricsCounter);
+
+// Benchmark a latency sample into a registered histogram
+static void BM_MetricsHistogram(benchmark::State& state) {
+    const metrics::Histogram latency = metrics::histogram("bench_latency_us");
+    uint64_t value = 1;
+
+    for (auto _ : state) {
+        latency.record(value);
+        value = value * 7 % 10007;
+    }
+}
+BENCHMARK(BM_MetricsHistogram);
@@ -1,32 +1,139 @@
 // benchmarks/url_benchmark.cpp
+#include "bench_support.hpp"
 #include <benchmark/benchmark.h>
 #include <seedlib/url.hpp>
+#include <seedlib/host_interner.hpp>
+#include <seedlib/url_batch.hpp>
+#include <seedlib/url_cache.hpp>
+#include <seedlib/url_matcher.hpp>
+#include <seedlib/percent_encoding.hpp>
+#include <algorithm>
 #include <random>
+#include <sstream>
+#include <thread>
 #include <vector>
 
 using namespace seedlib;
 
+// Inputs shared by the parse and validation benchmarks, indexed by the
+// benchmark argument: short, then query-heavy tracking and encoded URLs
+// where validation should pull ahead of parsing
+static const std::string& parse_input(int64_t index) {
+    static const std::string inputs[] = {
+        "https://example.com:8080/path?query=value#fragment",
+        "https://shop.example.co.uk/products/outdoor/tents/ultralight-2p?utm_source=newsletter&utm_medium=email"
+        "&utm_campaign=spring_sale_2024&utm_content=Xk2mQ9pL4vRt&utm_term=tent_2p&gclid=EAIaIQobChMI8uKz7dqY_gIVk"
+        "4hoCR0TnwGdEAAYASAAEgK3lPD_BwE&fbclid=IwAR3kQ9xLmN2pR7sT4vW8yZ1bC5dF6gH0jK3lM9nP2qR5sT8uV1wX4yZ7aB0cD"
+        "&mc_eid=4f9a1c7e2b&ref=homepage_banner#reviews",
+        "https://api.service.internal/search/%E6%97%A5%E6%9C%AC%E8%AA%9E?q=%E6%9D%B1%E4%BA%AC%E3%81%AE%E5%A4%A9"
+        "%E6%B0%97+%E6%98%8E%E6%97%A5&filters=%7B%22price%22%3A%5B10%2C250%5D%2C%22tags%22%3A%5B%22outdoor%22%5D"
+        "%7D&redirect=https%3A%2F%2Fwww.example.com%2Fcallback%3Fsession%3Dd41d8cd98f00b204e9800998ecf8427e",
+    };
+    return inputs[index];
+}
+
 // Benchmark URL parsing
 static void BM_URLParse(benchmark::State& state) {
-    const std::string url = "https://example.com:8080/path?query=value#fragment";
+    const std::string& url = parse_input(state.range(0));
 
     for (auto _ : state) {
         auto result = URL::parse(url);
         benchmark::DoNotOptimize(result);
     }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(url.size()));
 }
-BENCHMARK(BM_URLParse);
+BENCHMARK(BM_URLParse)->DenseRange(0, 2);
 
-// Benchmark URL validation
-static void BM_URLValidate(benchmark::State& state) {
+// Benchmark zero-copy view parsing
+static void BM_URLViewParse(benchmark::State& state) {
+    const std::string url = "https://example.com:8080/path?query=value#fragment";
+
+    for (auto _ : state) {
+        auto result = URLView::parse(url);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_URLViewParse);
+
+// Benchmark parsing with the host taken from a shared pool
+static void BM_URLParseInterned(benchmark::State& state) {
+    HostInterner interner;
+    const std::string url = "https://example.com:8080/path?query=value#fragment";
+
+    for (auto _ : state) {
+        auto result = URL::parse(url, interner);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_URLParseInterned);
+
+// Benchmark request-scoped parsing: a batch of URLs per arena, then release
+static void BM_URLParseArena(benchmark::State& state) {
     const std::string url = "https://example.com:8080/path?query=value#fragment";
+    Arena arena(64 * 1024);
+    constexpr int kPerRequest = 64;
+
+    for (auto _ : state) {
+        for (int i = 0; i < kPerRequest; ++i) {
+            auto result = URL::parse(url, arena);
+            benchmark::DoNotOptimize(result);
+        }
+        arena.release();
+    }
+    state.SetItemsProcessed(state.iterations() * kPerRequest);
+}
+BENCHMARK(BM_URLParseArena);
+
+// Benchmark URL validation on the same inputs as BM_URLParse
+static void BM_URLValidate(benchmark::State& state) {
+    const std::string& url = parse_input(state.range(0));
 
     for (auto _ : state) {
         auto result = URL::validate(url);
         benchmark::DoNotOptimize(result);
     }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(url.size()));
+}
+BENCHMARK(BM_URLValidate)->DenseRange(0, 2);
+
+// Benchmark the allocation-free check under each profile
+static void BM_URLCheck(benchmark::State& state) {
+    const std::string url = "https://example.com:8080/path?query=value#fragment";
+    const auto profile = static_cast<ValidationProfile>(state.range(0));
+
+    for (auto _ : state) {
+        auto error = URL::check(url, profile);
+        benchmark::DoNotOptimize(error);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(url.size()));
+}
+BENCHMARK(BM_URLCheck)->Arg(static_cast<int>(ValidationProfile::rfc3986))
+                      ->Arg(static_cast<int>(ValidationProfile::whatwg));
+
+// Benchmark the non-throwing path on a mostly-malformed corpus
+static void BM_URLParseInvalid(benchmark::State& state) {
+    const std::vector<std::string> urls = {
+        "not a url",
+        "http://",
+        "://example.com",
+        "http://[invalid]",
+        "http://example.com:99999",
+        "http://example.com:80a",
+        "1http://example.com",
+        "https://example.com/valid?query=value",
+    };
+    size_t index = 0;
+    URLError error;
+
+    for (auto _ : state) {
+        auto result = URL::try_parse(urls[index % urls.size()], error);
+        benchmark::DoNotOptimize(result);
+        index++;
+    }
+
+    state.SetItemsProcessed(state.iterations());
 }
-BENCHMARK(BM_URLValidate);
+BENCHMARK(BM_URLParseInvalid);
 
 // Benchmark URL toString
 static void BM_URLToString(benchmark::State& state) {
@@ -39,6 +146,66 @@ static void BM_URLToString(benchmark::State& state) {
 }
 BENCHMARK(BM_URLToString);
 
+// Benchmark serializing into a reused buffer
+static void BM_URLAppendTo(benchmark::State& state) {
+    auto url = URL::parse("https://example.com:8080/path?query=value#fragment").value();
+    std::string buffer;
+
+    for (auto _ : state) {
+        buffer.clear();
+        url.append_to(buffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+}
+BENCHMARK(BM_URLAppendTo);
+
+// Benchmark a header-rewrite style host swap
+static void BM_URLSetHost(benchmark::State& state) {
+    auto url = URL::parse("https://example.com:8080/path?query=value#fragment").value();
+    const std::string_view hosts[] = {"origin.internal", "example.com"};
+    size_t index = 0;
+
+    for (auto _ : state) {
+        url.set_host(hosts[index++ & 1]);
+        benchmark::DoNotOptimize(url.host().data());
+    }
+}
+BENCHMARK(BM_URLSetHost);
+
+// Benchmark dedup keys: hashing the canonical form without materializing it
+static void BM_URLCanonicalHash(benchmark::State& state) {
+    auto url = URL::parse("HTTP://Example.COM:80/a/./b/../c/%7euser?q=%e2%82%ac#top").value();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(url.canonical_hash());
+    }
+}
+BENCHMARK(BM_URLCanonicalHash);
+
+static void BM_URLNormalize(benchmark::State& state) {
+    const auto original = URL::parse("HTTP://Example.COM:80/a/./b/../c/%7euser?q=%e2%82%ac#top").value();
+
+    for (auto _ : state) {
+        auto url = original;
+        url.normalize();
+        benchmark::DoNotOptimize(url.path().data());
+    }
+}
+BENCHMARK(BM_URLNormalize);
+
+// Benchmark crawler-style href resolution against one base
+static void BM_URLResolve(benchmark::State& state) {
+    const auto base = URL::parse("https://example.com/docs/guide/index.html?lang=en").value();
+    const std::string_view refs[] = {"../api/url.html#resolve", "intro.html", "/static/app.css", "?page=2"};
+    size_t index = 0;
+
+    for (auto _ : state) {
+        auto result = base.resolve(refs[index++ & 3]);
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_URLResolve);
+
 // Benchmark with different URL lengths
 static void BM_URLParse_Length(benchmark::State& state) {
     const int length = state.range(0);
@@ -52,13 +219,41 @@ static void BM_URLParse_Length(benchmark::State& state) {
 }
 BENCHMARK(BM_URLParse_Length)->Range(8, 8<<10);
 
-// Generate random URLs for throughput testing
+// Benchmark percent-decoding a query-heavy analytics string
+static void BM_PercentDecode(benchmark::State& state) {
+    const std::string query =
+        "utm_source=newsletter&utm_medium=email&utm_campaign=spring%20sale%202024"
+        "&redirect=https%3A%2F%2Fexample.com%2Flanding%3Fref%3Dabc&q=red+shoes";
+    std::string buffer(query.size(), '\0');
+
+    for (auto _ : state) {
+        auto result = percent_decode(query, buffer.data());
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(query.size()));
+}
+BENCHMARK(BM_PercentDecode);
+
+// Benchmark looking up one parameter out of many
+static void BM_QueryParamFind(benchmark::State& state) {
+    auto url = URL::parse(
+        "https://example.com/track?utm_source=a&utm_medium=b&utm_campaign=c&utm_term=d"
+        "&utm_content=e&ref=f&session=g&lang=en&country=us&device=mobile&page=3").value();
+
+    for (auto _ : state) {
+        auto param = url.query_params().find("page");
+        benchmark::DoNotOptimize(param);
+    }
+}
+BENCHMARK(BM_QueryParamFind);
+
+// Generate random URLs for throughput testing; seeded so runs compare
 static std::vector<std::string> generate_random_urls(size_t count) {
     std::vector<std::string> urls;
     urls.reserve(count);
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    std::mt19937 gen(12345);
     std::uniform_int_distribution<> port_dist(1, 65535);
 
     const char* schemes[] = {"http", "https", "ws", "wss", "ftp"};
@@ -77,20 +272,122 @@ static std::vector<std::string> generate_random_urls(size_t count) {
     return urls;
 }
 
-// Benchmark parsing throughput
+// Benchmark parsing throughput. Args: zipf (0 = round robin over 1000 URLs,
+// 1 = Zipf over 10000), cache (0 = parse every time, 1 = URLCache)
 static void BM_URLThroughput(benchmark::State& state) {
-    const size_t url_count = 1000;
+    const bool zipf = state.range(0) != 0;
+    const bool cached = state.range(1) != 0;
+    const size_t url_count = zipf ? 10000 : 1000;
     auto urls = generate_random_urls(url_count);
+
+    std::vector<size_t> order;
+    if (zipf) {
+        order = bench::zipf_indices(url_count, 1 << 16);
+    } else {
+        for (size_t i = 0; i < url_count; ++i) order.push_back(i);
+    }
+
+    URLCache cache(4096);
     size_t index = 0;
 
     for (auto _ : state) {
-        auto result = URL::parse(urls[index % url_count]);
-        benchmark::DoNotOptimize(result);
+        const std::string& url = urls[order[index % order.size()]];
+        if (cached) {
+            auto result = cache.parse(url);
+            benchmark::DoNotOptimize(result);
+        } else {
+            auto result = URL::parse(url);
+            benchmark::DoNotOptimize(result);
+        }
         index++;
     }
 
     state.SetItemsProcessed(state.iterations());
+    if (cached) {
+        const auto stats = cache.stats();
+        state.counters["hit_ratio"] =
+            static_cast<double>(stats.hits) / static_cast<double>(std::max<uint64_t>(1, stats.hits + stats.misses));
+    }
+}
+BENCHMARK(BM_URLThroughput)
+    ->ArgNames({"zipf", "cache"})
+    ->Args({0, 0})
+    ->Args({1, 0})
+    ->Args({1, 1});
+
+// Benchmark columnar batch parsing with a reused batch
+static void BM_URLBatchParse(benchmark::State& state) {
+    auto urls = generate_random_urls(static_cast<size_t>(state.range(0)));
+    std::vector<std::string_view> views(urls.begin(), urls.end());
+    URLBatch batch;
+
+    for (auto _ : state) {
+        parse_batch(views, batch);
+        benchmark::DoNotOptimize(batch.valid_bits().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
 }
-BENCHMARK(BM_URLThroughput);
+BENCHMARK(BM_URLBatchParse)->Range(1<<10, 1<<16);
 
-BENCHMARK_MAIN();
+// Benchmark parallel batch parsing from 1 thread up to every core
+static void BM_URLBatchParallel(benchmark::State& state) {
+    auto urls = generate_random_urls(1 << 18);
+    std::vector<std::string_view> views(urls.begin(), urls.end());
+    const auto threads = static_cast<unsigned>(state.range(0));
+    URLBatch batch;
+
+    for (auto _ : state) {
+        parse_batch(views, batch, threads);
+        benchmark::DoNotOptimize(batch.valid_bits().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(views.size()));
+}
+
+static void thread_counts(benchmark::internal::Benchmark* bench) {
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads < cores; threads *= 2) {
+        bench->Arg(threads);
+    }
+    bench->Arg(cores);
+}
+BENCHMARK(BM_URLBatchParallel)->Apply(thread_counts)->UseRealTime();
+
+// Benchmark rule matching as the rule count grows; the time per URL
+// should stay flat
+static void BM_URLMatcherMatch(benchmark::State& state) {
+    const auto rule_count = static_cast<size_t>(state.range(0));
+    URLRuleSet rules;
+    for (size_t i = 0; i < rule_count; ++i) {
+        const std::string host = "host" + std::to_string(i % 1000) + ".example.com";
+        switch (i % 4) {
+        case 0: rules.add("*." + host + "/*", static_cast<uint32_t>(i)); break;
+        case 1: rules.add(host + "/api/v" + std::to_string(i % 7) + "/*", static_cast<uint32_t>(i)); break;
+        case 2: rules.add("https://" + host + "/static/" + std::to_string(i) + ".js", static_cast<uint32_t>(i)); break;
+        default: rules.add(host + "/users/" + std::to_string(i) + "/orders", static_cast<uint32_t>(i)); break;
+        }
+    }
+    const URLMatcher matcher(rules);
+
+    std::vector<std::string> urls;
+    for (size_t i = 0; i < 256; ++i) {
+        urls.push_back("https://www.host" + std::to_string(i * 7 % 1000) + ".example.com/api/v" +
+                       std::to_string(i % 7) + "/users/" + std::to_string(i) + "?page=2");
+        urls.push_back("https://host" + std::to_string(i * 13 % 1000) + ".example.com/static/" + std::to_string(i) +
+                       ".js");
+    }
+    std::vector<URLView> views;
+    for (const auto& url : urls) views.push_back(*URLView::parse(url));
+    std::vector<uint32_t> ids;
+
+    for (auto _ : state) {
+        for (const URLView& view : views) {
+            matcher.match(view, ids);
+            benchmark::DoNotOptimize(ids.data());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(views.size()));
+}
+BENCHMARK(BM_URLMatcherMatch)->Range(1<<8, 1<<16);
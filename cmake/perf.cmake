@@ -0,0 +1,62 @@
+# cmake/perf.cmake
+#
+# Performance build settings, applied to every target defined after this
+# file is included (the library, apps, tests and benchmarks alike):
+#
+#   SEEDLIB_PERF      Release by default, with link-time optimization
+#   SEEDLIB_MARCH     -march target, e.g. native, x86-64-v3; empty for the
+#                     compiler default. The SIMD scanner dispatches on the
+#                     CPU at run time either way; this lets the rest of the
+#                     code use the wider instruction set too.
+#   SEEDLIB_PGO       OFF, GENERATE or USE. GENERATE instruments the build
+#                     and adds a pgo_train target that runs the corpus
+#                     benchmarks; reconfiguring the same build directory
+#                     with USE rebuilds against the recorded profile.
+#   SEEDLIB_PGO_DIR   Where the profile is written and read
+#
+# CMakePresets.json has perf, perf-x86-64-v3 and the perf-pgo-generate /
+# perf-pgo-use pair.
+
+option(SEEDLIB_PERF "Optimized build: Release with LTO" OFF)
+set(SEEDLIB_MARCH "" CACHE STRING "Value for -march (e.g. native, x86-64-v3); empty for the compiler default")
+set(SEEDLIB_PGO "OFF" CACHE STRING "Profile-guided optimization stage: OFF, GENERATE or USE")
+set_property(CACHE SEEDLIB_PGO PROPERTY STRINGS OFF GENERATE USE)
+set(SEEDLIB_PGO_DIR "${CMAKE_BINARY_DIR}/pgo-profile" CACHE PATH "Profile directory for SEEDLIB_PGO")
+
+if(SEEDLIB_PERF)
+  include(CheckIPOSupported)
+  check_ipo_supported(RESULT seedlib_ipo_supported OUTPUT seedlib_ipo_output LANGUAGES CXX)
+  if(seedlib_ipo_supported)
+    set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)
+  else()
+    message(WARNING "SEEDLIB_PERF: link-time optimization is not supported: ${seedlib_ipo_output}")
+  endif()
+endif()
+
+if(SEEDLIB_MARCH)
+  add_compile_options(-march=${SEEDLIB_MARCH})
+endif()
+
+if(SEEDLIB_PGO STREQUAL "GENERATE")
+  # Atomic counters: the batch parser and several benchmarks are threaded
+  add_compile_options(-fprofile-generate=${SEEDLIB_PGO_DIR} -fprofile-update=atomic)
+  add_link_options(-fprofile-generate=${SEEDLIB_PGO_DIR})
+elseif(SEEDLIB_PGO STREQUAL "USE")
+  if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+    set(seedlib_profile "${SEEDLIB_PGO_DIR}/default.profdata")
+    if(NOT EXISTS "${seedlib_profile}")
+      message(FATAL_ERROR "SEEDLIB_PGO=USE: no ${seedlib_profile}; build pgo_train with SEEDLIB_PGO=GENERATE first")
+    endif()
+    add_compile_options(-fprofile-use=${seedlib_profile} -Wno-profile-instr-unprofiled)
+    add_link_options(-fprofile-use=${seedlib_profile})
+  else()
+    if(NOT EXISTS "${SEEDLIB_PGO_DIR}")
+      message(FATAL_ERROR "SEEDLIB_PGO=USE: no ${SEEDLIB_PGO_DIR}; build pgo_train with SEEDLIB_PGO=GENERATE first")
+    endif()
+    # Code the corpus never reaches keeps its normal optimization
+    add_compile_options(-fprofile-use=${SEEDLIB_PGO_DIR} -fprofile-partial-training -Wno-missing-profile)
+    add_link_options(-fprofile-use=${SEEDLIB_PGO_DIR})
+  endif()
+elseif(NOT SEEDLIB_PGO STREQUAL "OFF")
+  message(FATAL_ERROR "SEEDLIB_PGO must be OFF, GENERATE or USE")
+endif()
@@ -1 +1,37 @@
-// TODO: Basic usage example
+// examples/url_example.cpp
+//
+// Parses a URL, reads its components and query, resolves a relative
+// reference against it and prints the normalized form.
+#include <seedlib/url.hpp>
+
+#include <cstdio>
+#include <string>
+
+int main(int argc, char** argv) {
+    const char* input = argc > 1 ? argv[1] : "https://Example.com:8443/docs/./guide/../api?lang=en&q=url%20parsing#top";
+
+    seedlib::URLError error;
+    auto url = seedlib::URL::try_parse(input, error);
+    if (!url) {
+        std::fprintf(stderr, "%s: %s at offset %u\n", input, error.message(), static_cast<unsigned>(error.offset));
+        return 1;
+    }
+
+    std::printf("scheme    %.*s\n", static_cast<int>(url->scheme().size()), url->scheme().data());
+    std::printf("host      %.*s\n", static_cast<int>(url->host().size()), url->host().data());
+    std::printf("port      %u\n", static_cast<unsigned>(url->port()));
+    std::printf("path      %.*s\n", static_cast<int>(url->path().size()), url->path().data());
+    for (const auto& param : url->query_params()) {
+        const std::string value = param.decoded_value();
+        std::printf("query     %.*s = %s\n", static_cast<int>(param.key.size()), param.key.data(), value.c_str());
+    }
+    std::printf("fragment  %.*s\n", static_cast<int>(url->fragment().size()), url->fragment().data());
+
+    if (auto next = url->resolve("../changelog?since=1.0")) {
+        std::printf("resolved  %s\n", next->to_string().c_str());
+    }
+
+    url->normalize();
+    std::printf("normal    %s\n", url->to_string().c_str());
+    return 0;
+}
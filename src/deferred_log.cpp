@@ -0,0 +1,434 @@
+// src/deferred_log.cpp
+#include "seedlib/deferred_log.hpp"
+#include <fmt/args.h>
+#include <fmt/chrono.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace seedlib {
+
+using detail::deferred::RecordHeader;
+using detail::deferred::Ring;
+
+namespace {
+    namespace d = detail::deferred;
+
+    // Binary log layout, native byte order:
+    //   "SEEDLOG1"
+    //   'F' u32 id, u32 length, format, u32 length, type codes   (first use)
+    //   'R' u32 id, u8 level, i64 time_ns, u32 length, arguments
+    constexpr char kMagic[8] = {'S', 'E', 'E', 'D', 'L', 'O', 'G', '1'};
+
+    using ArgStore = fmt::dynamic_format_arg_store<fmt::format_context>;
+
+    // Size of the encoded arguments at p, or -1 if they overrun end
+    ptrdiff_t arguments_size(const char* types, const char* p, const char* end) {
+        const char* const begin = p;
+        for (; *types; ++types) {
+            size_t size;
+            switch (*types) {
+            case d::kBool:
+            case d::kChar:
+                size = 1;
+                break;
+            case d::kString: {
+                uint32_t length;
+                if (end - p < static_cast<ptrdiff_t>(sizeof(length))) return -1;
+                std::memcpy(&length, p, sizeof(length));
+                size = sizeof(length) + length;
+                break;
+            }
+            default:
+                size = 8;
+                break;
+            }
+            if (static_cast<size_t>(end - p) < size) return -1;
+            p += size;
+        }
+        return p - begin;
+    }
+
+    // Loads arguments already bounds-checked by arguments_size; strings
+    // are referenced in place, so p must outlive the formatting
+    void load_arguments(const char* types, const char* p, ArgStore& store) {
+        store.clear();
+        for (; *types; ++types) {
+            uint64_t bits = 0;
+            switch (*types) {
+            case d::kBool:
+                store.push_back(*p != 0);
+                p += 1;
+                continue;
+            case d::kChar:
+                store.push_back(*p);
+                p += 1;
+                continue;
+            case d::kString: {
+                uint32_t length;
+                std::memcpy(&length, p, sizeof(length));
+                store.push_back(fmt::string_view(p + sizeof(length), length));
+                p += sizeof(length) + length;
+                continue;
+            }
+            default:
+                std::memcpy(&bits, p, sizeof(bits));
+                p += sizeof(bits);
+                break;
+            }
+            switch (*types) {
+            case d::kInt: {
+                int64_t value;
+                std::memcpy(&value, &bits, sizeof(value));
+                store.push_back(value);
+                break;
+            }
+            case d::kDouble: {
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                store.push_back(value);
+                break;
+            }
+            case d::kPointer:
+                store.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(bits)));
+                break;
+            default:
+                store.push_back(bits);
+                break;
+            }
+        }
+    }
+
+    // A bad format becomes part of the line rather than an exception on
+    // the formatter thread
+    void render(std::string_view format, const ArgStore& store, fmt::memory_buffer& out) {
+        const size_t start = out.size();
+        try {
+            fmt::vformat_to(std::back_inserter(out), fmt::string_view(format.data(), format.size()), store);
+        } catch (const fmt::format_error& ex) {
+            out.resize(start);
+            fmt::format_to(std::back_inserter(out), "[bad deferred format: {}] {}", ex.what(), format);
+        }
+    }
+
+    template <typename T>
+    void write(std::FILE* file, const T& value) {
+        std::fwrite(&value, sizeof(value), 1, file);
+    }
+
+    void write(std::FILE* file, std::string_view text) {
+        write(file, static_cast<uint32_t>(text.size()));
+        std::fwrite(text.data(), 1, text.size(), file);
+    }
+
+    template <typename T>
+    bool read(std::istream& in, T& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    bool read(std::istream& in, std::string& text) {
+        uint32_t length;
+        if (!read(in, length)) return false;
+        text.resize(length);
+        return length == 0 || static_cast<bool>(in.read(text.data(), length));
+    }
+
+    // Decoder lines are stamped in UTC so they read the same anywhere
+    void append_prefix(fmt::memory_buffer& out, int64_t time_ns, uint8_t level) {
+        const std::time_t seconds = static_cast<std::time_t>(time_ns / 1000000000);
+        const auto nanos = static_cast<long>(time_ns % 1000000000);
+        const auto name = spdlog::level::to_string_view(static_cast<spdlog::level::level_enum>(level));
+        fmt::format_to(std::back_inserter(out), "[{:%Y-%m-%d %H:%M:%S}.{:09}Z] [{}] ", fmt::gmtime(seconds), nanos,
+                       std::string_view(name.data(), name.size()));
+    }
+
+    struct FormatKey {
+        const char* format;
+        const char* types;
+        bool operator==(const FormatKey& other) const { return format == other.format && types == other.types; }
+    };
+
+    struct FormatKeyHash {
+        size_t operator()(const FormatKey& key) const {
+            return std::hash<const void*>()(key.format) * 31 + std::hash<const void*>()(key.types);
+        }
+    };
+
+    // Ties a ring to its thread so the ring is retired when the thread exits
+    struct RingOwner {
+        Ring* ring{nullptr};
+        ~RingOwner() {
+            if (ring) ring->retired.store(true, std::memory_order_release);
+        }
+    };
+}
+
+struct DeferredLog::State {
+    std::mutex mutex;  // Guards everything up to the consumer-only section
+    std::condition_variable wake;
+    std::condition_variable flushed;
+    std::vector<std::unique_ptr<Ring>> rings;
+    uint64_t generation{0};  // Bumped whenever rings changes
+    uint64_t flush_requests{0};
+    uint64_t flushes_done{0};
+    bool stopping{false};
+    bool running{false};
+    size_t ring_bytes{0};
+    std::chrono::microseconds idle_sleep{0};
+    std::thread consumer;
+
+    // Consumer-only
+    std::shared_ptr<spdlog::logger> logger;
+    std::FILE* binary{nullptr};
+    std::unordered_map<FormatKey, uint32_t, FormatKeyHash> format_ids;
+};
+
+DeferredLog DeferredLog::instance_;
+
+DeferredLog::~DeferredLog() {
+    stop();
+}
+
+void DeferredLog::start(DeferredLogOptions options) {
+    stop();
+    if (!state_) state_ = std::make_unique<State>();
+    State& state = *state_;
+
+    std::FILE* binary = nullptr;
+    if (!options.binary_path.empty()) {
+        binary = std::fopen(options.binary_path.c_str(), "wb");
+        if (!binary) throw std::runtime_error("cannot open deferred log file " + options.binary_path);
+        std::fwrite(kMagic, 1, sizeof(kMagic), binary);
+    }
+
+    size_t ring_bytes = 4096;
+    while (ring_bytes < options.ring_bytes) ring_bytes <<= 1;
+
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.stopping = false;
+        state.running = true;
+        state.ring_bytes = ring_bytes;
+        state.idle_sleep = options.idle_sleep;
+    }
+    state.logger = options.logger ? options.logger : spdlog::default_logger();
+    state.binary = binary;
+    state.format_ids.clear();
+    state.consumer = std::thread([this, &state] { run(state); });
+
+    // Published last: producers read state_ only after seeing a level
+    level_.store(options.level, std::memory_order_release);
+}
+
+void DeferredLog::stop() {
+    if (!state_) return;
+    State& state = *state_;
+    level_.store(spdlog::level::off, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (!state.running) return;
+        state.stopping = true;
+    }
+    state.wake.notify_all();
+    state.consumer.join();
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.running = false;
+    if (state.binary) {
+        std::fclose(state.binary);
+        state.binary = nullptr;
+    }
+}
+
+bool DeferredLog::running() const noexcept {
+    if (!state_) return false;
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->running;
+}
+
+void DeferredLog::flush() {
+    if (!state_) return;
+    State& state = *state_;
+    std::unique_lock<std::mutex> lock(state.mutex);
+    if (!state.running) return;
+    const uint64_t ticket = ++state.flush_requests;
+    state.wake.notify_all();
+    state.flushed.wait(lock, [&] { return state.flushes_done >= ticket || !state.running; });
+}
+
+Ring* DeferredLog::attach_thread() {
+    // Pairs with the release in start(), so state_ is visible here
+    level_.load(std::memory_order_acquire);
+    State& state = *state_;
+
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.rings.push_back(std::make_unique<Ring>(state.ring_bytes));
+    ++state.generation;
+
+    static thread_local RingOwner owner;
+    owner.ring = state.rings.back().get();
+    return owner.ring;
+}
+
+void DeferredLog::run(State& state) {
+    ArgStore store;
+    fmt::memory_buffer line;
+    std::vector<Ring*> rings;
+    uint64_t seen_generation = ~uint64_t{0};
+
+    auto write_binary = [&state](const RecordHeader& header, const char* arguments, size_t size) {
+        std::FILE* file = state.binary;
+        auto [it, inserted] = state.format_ids.try_emplace(FormatKey{header.format, header.types},
+                                                           static_cast<uint32_t>(state.format_ids.size()));
+        if (inserted) {
+            std::fputc('F', file);
+            write(file, it->second);
+            write(file, std::string_view(header.format, header.format_size));
+            write(file, std::string_view(header.types));
+        }
+        std::fputc('R', file);
+        write(file, it->second);
+        write(file, header.level);
+        write(file, header.time_ns);
+        write(file, std::string_view(arguments, size));
+    };
+
+    auto handle = [&](const char* record) {
+        RecordHeader header;
+        std::memcpy(&header, record, sizeof(header));
+        const char* arguments = record + sizeof(header);
+        const ptrdiff_t size = arguments_size(header.types, arguments, record + header.size);
+        if (size < 0) return;
+
+        if (state.binary) {
+            write_binary(header, arguments, static_cast<size_t>(size));
+            return;
+        }
+        line.clear();
+        load_arguments(header.types, arguments, store);
+        render(std::string_view(header.format, header.format_size), store, line);
+        const auto time = spdlog::log_clock::time_point(
+            std::chrono::duration_cast<spdlog::log_clock::duration>(std::chrono::nanoseconds(header.time_ns)));
+        state.logger->log(time, spdlog::source_loc{}, static_cast<spdlog::level::level_enum>(header.level),
+                          spdlog::string_view_t(line.data(), line.size()));
+    };
+
+    auto flush_output = [&state] {
+        if (state.binary) {
+            std::fflush(state.binary);
+        } else {
+            state.logger->flush();
+        }
+    };
+
+    for (;;) {
+        uint64_t requested;
+        bool stopping;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            requested = state.flush_requests;
+            stopping = state.stopping;
+            if (state.generation != seen_generation) {
+                rings.clear();
+                for (auto& ring : state.rings) rings.push_back(ring.get());
+                seen_generation = state.generation;
+            }
+        }
+
+        size_t handled = 0;
+        bool retired = false;
+        for (Ring* ring : rings) {
+            // Read before draining: a retired ring gets no more records
+            const bool gone = ring->retired.load(std::memory_order_acquire);
+            handled += ring->drain(handle);
+            retired |= gone;
+        }
+
+        std::unique_lock<std::mutex> lock(state.mutex);
+        if (retired) {
+            auto& all = state.rings;
+            const auto end = std::remove_if(all.begin(), all.end(), [](const std::unique_ptr<Ring>& ring) {
+                return ring->retired.load(std::memory_order_acquire) && ring->tail() == ring->head();
+            });
+            if (end != all.end()) {
+                all.erase(end, all.end());
+                ++state.generation;
+            }
+        }
+        if (stopping) {
+            flush_output();
+            state.flushes_done = state.flush_requests;
+            state.flushed.notify_all();
+            return;
+        }
+        if (requested != state.flushes_done) {
+            flush_output();
+            state.flushes_done = requested;
+            state.flushed.notify_all();
+        }
+        if (handled == 0) {
+            state.wake.wait_for(lock, state.idle_sleep,
+                                [&] { return state.stopping || state.flush_requests != state.flushes_done; });
+        }
+    }
+}
+
+bool decode_deferred_log(std::istream& in, std::ostream& out) {
+    char magic[sizeof(kMagic)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) return false;
+
+    struct Format {
+        std::string text;
+        std::string types;
+    };
+    std::vector<Format> formats;
+    std::string arguments;
+    ArgStore store;
+    fmt::memory_buffer line;
+
+    for (;;) {
+        const int tag = in.get();
+        if (tag == std::char_traits<char>::eof()) return true;
+
+        uint32_t id;
+        if (!read(in, id)) return false;
+        if (tag == 'F') {
+            Format format;
+            if (id != formats.size() || !read(in, format.text) || !read(in, format.types)) return false;
+            formats.push_back(std::move(format));
+            continue;
+        }
+
+        uint8_t level;
+        int64_t time_ns;
+        if (tag != 'R' || id >= formats.size() || !read(in, level) || !read(in, time_ns) ||
+            !read(in, arguments) || level > spdlog::level::off) {
+            return false;
+        }
+        const Format& format = formats[id];
+        const char* begin = arguments.data();
+        if (arguments_size(format.types.c_str(), begin, begin + arguments.size()) !=
+            static_cast<ptrdiff_t>(arguments.size())) {
+            return false;
+        }
+
+        line.clear();
+        append_prefix(line, time_ns, level);
+        load_arguments(format.types.c_str(), begin, store);
+        render(format.text, store, line);
+        line.push_back('\n');
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }
+}
+
+} // namespace seedlib
@@ -0,0 +1,119 @@
+// src/host.cpp
+#include "seedlib/host.hpp"
+
+namespace seedlib {
+
+namespace {
+    // Digit value, or a value above 9 for anything else
+    inline unsigned digit(char c) {
+        return static_cast<unsigned>(static_cast<unsigned char>(c) - '0');
+    }
+
+    inline int hex_value(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+}
+
+// Each octet reads its (up to) three digit slots unconditionally and picks
+// the value by digit count, so the only branches are the accept/reject ones
+bool parse_ipv4(std::string_view text, std::array<uint8_t, 4>& out) noexcept {
+    if (text.size() < 7 || text.size() > 15) return false;
+
+    const char* p = text.data();
+    const char* const end = p + text.size();
+    for (int i = 0; i < 4; ++i) {
+        if (i != 0) {
+            if (p == end || *p != '.') return false;
+            ++p;
+        }
+        const size_t left = static_cast<size_t>(end - p);
+        const unsigned d0 = left > 0 ? digit(p[0]) : 10;
+        const unsigned d1 = left > 1 ? digit(p[1]) : 10;
+        const unsigned d2 = left > 2 ? digit(p[2]) : 10;
+        if (d0 > 9) return false;
+
+        const unsigned two = d1 <= 9;
+        const unsigned three = two & (d2 <= 9);
+        const unsigned count = 1 + two + three;
+        const unsigned value = three ? d0 * 100 + d1 * 10 + d2 : two ? d0 * 10 + d1 : d0;
+        if (value > 255 || (count > 1 && d0 == 0)) return false;
+
+        out[static_cast<size_t>(i)] = static_cast<uint8_t>(value);
+        p += count;
+    }
+    return p == end;
+}
+
+bool parse_ipv6(std::string_view text, std::array<uint8_t, 16>& out) noexcept {
+    uint16_t groups[8] = {};
+    int count = 0;
+    int compress = -1;  // Group index where "::" stands
+
+    const char* p = text.data();
+    const char* const end = p + text.size();
+    if (end - p >= 2 && p[0] == ':' && p[1] == ':') {
+        compress = 0;
+        p += 2;
+    } else if (p == end || *p == ':') {
+        return false;
+    }
+
+    while (p != end) {
+        if (count == 8) return false;
+
+        const char* group_begin = p;
+        unsigned value = 0;
+        for (int value_digit; p != end && p - group_begin < 4 && (value_digit = hex_value(*p)) >= 0; ++p) {
+            value = value << 4 | static_cast<unsigned>(value_digit);
+        }
+        if (p == group_begin) return false;
+
+        if (p != end && *p == '.') {
+            // Trailing dotted IPv4 fills the last two groups
+            std::array<uint8_t, 4> v4;
+            if (count > 6 || !parse_ipv4(std::string_view(group_begin, static_cast<size_t>(end - group_begin)), v4)) {
+                return false;
+            }
+            groups[count++] = static_cast<uint16_t>(v4[0] << 8 | v4[1]);
+            groups[count++] = static_cast<uint16_t>(v4[2] << 8 | v4[3]);
+            p = end;
+            break;
+        }
+
+        groups[count++] = static_cast<uint16_t>(value);
+        if (p == end) break;
+        if (*p != ':') return false;
+        ++p;
+        if (p != end && *p == ':') {
+            if (compress >= 0) return false;
+            compress = count;
+            ++p;
+        } else if (p == end) {
+            return false;
+        }
+    }
+
+    if (compress < 0 ? count != 8 : count > 7) return false;
+
+    // Move the groups after "::" to the end, zero-filling the gap
+    if (compress >= 0) {
+        const int tail = count - compress;
+        for (int i = 0; i < tail; ++i) {
+            groups[7 - i] = groups[count - 1 - i];
+        }
+        for (int i = compress; i < 8 - tail; ++i) {
+            groups[i] = 0;
+        }
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        out[static_cast<size_t>(2 * i)] = static_cast<uint8_t>(groups[i] >> 8);
+        out[static_cast<size_t>(2 * i + 1)] = static_cast<uint8_t>(groups[i]);
+    }
+    return true;
+}
+
+} // namespace seedlib
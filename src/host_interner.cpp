@@ -0,0 +1,156 @@
+// src/host_interner.cpp
+#include "seedlib/host_interner.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace seedlib {
+
+namespace {
+    // Arena record; the text follows the header
+    struct Entry {
+        size_t hash;
+        uint32_t length;
+
+        const char* text() const { return reinterpret_cast<const char*>(this + 1); }
+        std::string_view view() const { return {text(), length}; }
+    };
+
+    struct Table {
+        explicit Table(size_t capacity)
+            : mask(capacity - 1), slots(new std::atomic<const Entry*>[capacity]) {
+            for (size_t i = 0; i < capacity; ++i) slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        size_t mask;
+        std::unique_ptr<std::atomic<const Entry*>[]> slots;
+    };
+
+    constexpr size_t kInitialCapacity = 64;
+    constexpr size_t kBlockSize = 64 * 1024;
+
+    // Slots come from the low hash bits, shards from the high ones
+    size_t shard_bits(size_t hash) { return hash >> (sizeof(size_t) * 8 - 16); }
+
+    const Entry* probe(const Table& table, size_t hash, std::string_view text) noexcept {
+        for (size_t i = hash & table.mask;; i = (i + 1) & table.mask) {
+            const Entry* entry = table.slots[i].load(std::memory_order_acquire);
+            if (entry == nullptr) return nullptr;
+            if (entry->hash == hash && entry->view() == text) return entry;
+        }
+    }
+
+    void insert(Table& table, const Entry* entry) noexcept {
+        size_t i = entry->hash & table.mask;
+        while (table.slots[i].load(std::memory_order_relaxed) != nullptr) {
+            i = (i + 1) & table.mask;
+        }
+        table.slots[i].store(entry, std::memory_order_release);
+    }
+}
+
+struct alignas(64) HostInterner::Shard {
+    Shard() : table(new Table(kInitialCapacity)) { tables.emplace_back(table.load()); }
+
+    // Writers hold mutex. Every table ever published stays in tables.
+    std::atomic<Table*> table;
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> reserved{0};
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Table>> tables;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char* cursor{nullptr};
+    size_t remaining{0};
+
+    const Entry* find(size_t hash, std::string_view text) const noexcept {
+        return probe(*table.load(std::memory_order_acquire), hash, text);
+    }
+
+    const Entry* add(size_t hash, std::string_view text) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        Table* current = table.load(std::memory_order_relaxed);
+        if (const Entry* existing = probe(*current, hash, text)) return existing;
+
+        // Keep the load factor under 3/4 so probe chains stay short
+        const size_t n = count.load(std::memory_order_relaxed);
+        if ((n + 1) * 4 > (current->mask + 1) * 3) {
+            auto grown = std::make_unique<Table>((current->mask + 1) * 2);
+            for (size_t i = 0; i <= current->mask; ++i) {
+                if (const Entry* entry = current->slots[i].load(std::memory_order_relaxed)) {
+                    insert(*grown, entry);
+                }
+            }
+            current = grown.get();
+            tables.push_back(std::move(grown));
+            table.store(current, std::memory_order_release);
+        }
+
+        Entry* entry = new (allocate(text.size())) Entry{hash, static_cast<uint32_t>(text.size())};
+        if (!text.empty()) std::memcpy(entry + 1, text.data(), text.size());
+        insert(*current, entry);
+        count.store(n + 1, std::memory_order_relaxed);
+        return entry;
+    }
+
+    void* allocate(size_t text_size) {
+        const size_t bytes = (sizeof(Entry) + text_size + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+        if (bytes > remaining) {
+            const size_t block = std::max(bytes, kBlockSize);
+            blocks.emplace_back(new char[block]);
+            cursor = blocks.back().get();
+            remaining = block;
+            reserved.fetch_add(block, std::memory_order_relaxed);
+        }
+        void* storage = cursor;
+        cursor += bytes;
+        remaining -= bytes;
+        return storage;
+    }
+};
+
+HostInterner::HostInterner(size_t shard_count) {
+    size_t shards = 1;
+    while (shards < shard_count && shards < (size_t{1} << 16)) shards <<= 1;
+    shards_.reset(new Shard[shards]);
+    shard_mask_ = shards - 1;
+}
+
+HostInterner::~HostInterner() = default;
+
+HostInterner::Shard& HostInterner::shard_for(size_t hash) const noexcept {
+    return shards_[shard_bits(hash) & shard_mask_];
+}
+
+std::string_view HostInterner::intern(std::string_view text) {
+    const size_t hash = std::hash<std::string_view>{}(text);
+    Shard& shard = shard_for(hash);
+    if (const Entry* entry = shard.find(hash, text)) return entry->view();
+    return shard.add(hash, text)->view();
+}
+
+std::string_view HostInterner::find(std::string_view text) const noexcept {
+    const size_t hash = std::hash<std::string_view>{}(text);
+    if (const Entry* entry = shard_for(hash).find(hash, text)) return entry->view();
+    return {};
+}
+
+size_t HostInterner::size() const noexcept {
+    size_t total = 0;
+    for (size_t i = 0; i <= shard_mask_; ++i) total += shards_[i].count.load(std::memory_order_relaxed);
+    return total;
+}
+
+size_t HostInterner::bytes_reserved() const noexcept {
+    size_t total = 0;
+    for (size_t i = 0; i <= shard_mask_; ++i) total += shards_[i].reserved.load(std::memory_order_relaxed);
+    return total;
+}
+
+} // namespace seedlib
@@ -0,0 +1,34 @@
+// src/include/seedlib/arena.hpp
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace seedlib {
+
+// Request-scoped monotonic arena. Deallocation is a no-op; everything is
+// released at once by release() or the destructor, so nothing allocated
+// from it may be used afterwards. Not thread-safe: use one per request.
+class Arena {
+public:
+  explicit Arena(size_t initial_size = 4096)
+      : resource_(initial_size, std::pmr::new_delete_resource()) {}
+
+  // Serves from buffer first (e.g. a stack array), then from the heap
+  Arena(void* buffer, size_t size) : resource_(buffer, size, std::pmr::new_delete_resource()) {}
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  std::pmr::memory_resource* resource() noexcept { return &resource_; }
+  void release() { resource_.release(); }
+
+private:
+  std::pmr::monotonic_buffer_resource resource_;
+};
+
+} // namespace seedlib
+
+#endif
@@ -0,0 +1,323 @@
+// src/include/seedlib/deferred_log.hpp
+
+#ifndef DEFERRED_LOG_HPP
+#define DEFERRED_LOG_HPP
+
+#include "seedlib/logging.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace seedlib {
+
+struct DeferredLogOptions {
+  // Ring per producing thread, rounded up to a power of two; records that
+  // do not fit are dropped and counted
+  size_t ring_bytes = size_t{1} << 20;
+  // Records below this level are not captured at all
+  spdlog::level::level_enum level = static_cast<spdlog::level::level_enum>(DEFAULT_LOG_LEVEL_VALUE);
+  // How long the formatter sleeps once every ring is empty
+  std::chrono::microseconds idle_sleep{200};
+  // Formatted output; spdlog's default logger when empty
+  std::shared_ptr<spdlog::logger> logger;
+  // When set, records are appended to this file unformatted instead, for
+  // decode_deferred_log() to render offline
+  std::string binary_path;
+};
+
+namespace detail::deferred {
+  // One code per argument; values are widened so a decoder sees few types
+  enum ArgCode : char {
+    kBool = 'b',
+    kChar = 'c',
+    kInt = 'i',     // int64_t
+    kUint = 'u',    // uint64_t
+    kDouble = 'd',
+    kPointer = 'p',  // uint64_t address
+    kString = 's',   // uint32_t length, then the bytes
+  };
+
+  template <typename T>
+  using arg_t = std::remove_cv_t<std::remove_reference_t<std::decay_t<T>>>;
+
+  template <typename T>
+  constexpr bool is_string_arg =
+    std::is_same_v<T, const char*> || std::is_same_v<T, char*> ||
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+  template <typename T>
+  constexpr char arg_code() {
+    using U = arg_t<T>;
+    if constexpr (std::is_same_v<U, bool>) return kBool;
+    else if constexpr (std::is_same_v<U, char>) return kChar;
+    else if constexpr (is_string_arg<U>) return kString;
+    else if constexpr (std::is_enum_v<U>) return std::is_signed_v<std::underlying_type_t<U>> ? kInt : kUint;
+    else if constexpr (std::is_integral_v<U>) return std::is_signed_v<U> ? kInt : kUint;
+    else if constexpr (std::is_floating_point_v<U>) return kDouble;
+    else if constexpr (std::is_pointer_v<U>) return kPointer;
+    else {
+      static_assert(std::is_pointer_v<U>, "deferred logging takes arithmetic, enum, pointer and string arguments");
+      return 0;
+    }
+  }
+
+  template <typename... Args>
+  inline constexpr char arg_codes[] = {arg_code<Args>()..., '\0'};
+
+  template <typename T>
+  std::string_view as_string(const T& value) {
+    if constexpr (std::is_pointer_v<T>) return value ? std::string_view(value) : std::string_view();
+    else return std::string_view(value);
+  }
+
+  template <typename T>
+  size_t encoded_size(const T& value) {
+    constexpr char code = arg_code<T>();
+    if constexpr (code == kString) return sizeof(uint32_t) + as_string(value).size();
+    else if constexpr (code == kBool || code == kChar) return 1;
+    else return 8;
+  }
+
+  template <typename T>
+  char* encode(char* out, const T& value) {
+    using U = arg_t<T>;
+    constexpr char code = arg_code<T>();
+    if constexpr (code == kString) {
+      const std::string_view text = as_string(value);
+      const auto length = static_cast<uint32_t>(text.size());
+      std::memcpy(out, &length, sizeof(length));
+      if (length != 0) std::memcpy(out + sizeof(length), text.data(), length);
+      return out + sizeof(length) + length;
+    } else if constexpr (code == kBool || code == kChar) {
+      *out = static_cast<char>(value);
+      return out + 1;
+    } else {
+      U copy = value;
+      uint64_t bits = 0;
+      if constexpr (code == kDouble) {
+        const double wide = static_cast<double>(copy);
+        std::memcpy(&bits, &wide, sizeof(bits));
+      } else if constexpr (code == kPointer) {
+        bits = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(copy));
+      } else if constexpr (code == kInt) {
+        const auto wide = static_cast<int64_t>(copy);
+        std::memcpy(&bits, &wide, sizeof(bits));
+      } else {
+        bits = static_cast<uint64_t>(copy);
+      }
+      std::memcpy(out, &bits, sizeof(bits));
+      return out + sizeof(bits);
+    }
+  }
+
+  // Fixed part of every record; the encoded arguments follow it
+  struct RecordHeader {
+    uint32_t size;         // Whole record, a multiple of 8; 0 marks a wrap
+    uint32_t format_size;
+    const char* format;    // Points into a string literal
+    const char* types;     // arg_codes<Args...>
+    int64_t time_ns;       // system_clock since the epoch
+    uint8_t level;
+  };
+
+  // Single-producer, single-consumer byte ring. Positions only grow; each
+  // side caches the other's so the shared lines are touched rarely.
+  class Ring {
+  public:
+    explicit Ring(size_t capacity)
+        : capacity_(capacity), mask_(capacity - 1), data_(new char[capacity]) {}
+
+    // Space for size bytes (a multiple of 8), or nullptr when full
+    char* reserve(size_t size) noexcept {
+      const uint64_t head = head_.load(std::memory_order_relaxed);
+      const size_t contiguous = capacity_ - static_cast<size_t>(head & mask_);
+      const size_t skip = contiguous < size ? contiguous : 0;
+      if (head + skip + size - cached_tail_ > capacity_) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (head + skip + size - cached_tail_ > capacity_) return nullptr;
+      }
+      if (skip != 0) {
+        const uint32_t wrap = 0;
+        std::memcpy(data_.get() + (head & mask_), &wrap, sizeof(wrap));
+      }
+      reserved_ = head + skip;
+      return data_.get() + (reserved_ & mask_);
+    }
+
+    void commit(size_t size) noexcept {
+      head_.store(reserved_ + size, std::memory_order_release);
+    }
+
+    // Consumer side: calls f(record) for each committed record in order,
+    // releasing its space once f returns; returns how many it saw
+    template <typename F>
+    size_t drain(F&& f) {
+      uint64_t tail = tail_.load(std::memory_order_relaxed);
+      const uint64_t head = head_.load(std::memory_order_acquire);
+      size_t count = 0;
+      while (tail != head) {
+        const char* record = data_.get() + (tail & mask_);
+        uint32_t size;
+        std::memcpy(&size, record, sizeof(size));
+        if (size == 0) {
+          tail += capacity_ - static_cast<size_t>(tail & mask_);
+        } else {
+          f(record);
+          tail += size;
+          ++count;
+        }
+        tail_.store(tail, std::memory_order_release);
+      }
+      return count;
+    }
+
+    uint64_t head() const noexcept { return head_.load(std::memory_order_acquire); }
+    uint64_t tail() const noexcept { return tail_.load(std::memory_order_acquire); }
+    size_t capacity() const noexcept { return capacity_; }
+
+    std::atomic<bool> retired{false};  // Set when the owning thread exits
+
+  private:
+    // Read-only after construction, so kept off both sides' lines
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<char[]> data_;
+
+    alignas(64) std::atomic<uint64_t> head_{0};
+    uint64_t reserved_{0};
+    uint64_t cached_tail_{0};
+    alignas(64) std::atomic<uint64_t> tail_{0};
+  };
+
+  // A format string that only a string literal converts to: the ring
+  // keeps the pointer, and binary output keys format ids on it, so the
+  // text must outlive the formatter and never change. Checked like
+  // fmt::format_string where fmt checks at compile time.
+  template <typename... Args>
+  struct FormatLiteral {
+    template <size_t N>
+    FMT_CONSTEVAL FormatLiteral(const char (&literal)[N]) : text(literal) {}
+
+    fmt::format_string<Args...> text;
+  };
+
+  inline int64_t now_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch()).count();
+  }
+}
+
+// Low-latency logging for hot threads: the calling thread only copies the
+// format string pointer and the raw arguments into its own ring, and a
+// background thread formats them (or writes them out in binary). Format
+// strings must be literals, which log() enforces. Threads must not log
+// from thread_local destructors, since their ring is retired when the
+// thread exits.
+class DeferredLog {
+public:
+  static DeferredLog& instance() noexcept { return instance_; }
+  ~DeferredLog();
+
+  void start(DeferredLogOptions options = {});
+  void stop();  // Drains what was captured, then joins the formatter
+
+  // Blocks until everything captured so far has been written out
+  void flush();
+
+  bool running() const noexcept;
+  uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+  bool should_log(spdlog::level::level_enum level) const noexcept {
+    return level >= level_.load(std::memory_order_relaxed);
+  }
+
+  template <typename... Args>
+  void log(spdlog::level::level_enum level, fmt::type_identity_t<detail::deferred::FormatLiteral<Args...>> format,
+           const Args&... args) {
+    namespace d = detail::deferred;
+    if (!should_log(level)) return;
+
+    const fmt::string_view text = format.text;
+    const size_t size = (sizeof(d::RecordHeader) + (size_t{0} + ... + d::encoded_size(args)) + 7) & ~size_t{7};
+    d::Ring* ring = thread_ring();
+    char* out = size <= ring->capacity() / 2 ? ring->reserve(size) : nullptr;
+    if (!out) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    const d::RecordHeader header{static_cast<uint32_t>(size), static_cast<uint32_t>(text.size()),
+                                 text.data(), d::arg_codes<Args...>, d::now_ns(),
+                                 static_cast<uint8_t>(level)};
+    std::memcpy(out, &header, sizeof(header));
+    [[maybe_unused]] char* p = out + sizeof(header);
+    ((p = d::encode(p, args)), ...);
+    ring->commit(size);
+  }
+
+private:
+  struct State;
+
+  constexpr DeferredLog() = default;
+  static DeferredLog instance_;
+
+  static detail::deferred::Ring* thread_ring() {
+    static thread_local detail::deferred::Ring* ring = nullptr;
+    if (!ring) ring = instance_.attach_thread();
+    return ring;
+  }
+  detail::deferred::Ring* attach_thread();
+  void run(State& state);
+
+  std::atomic<int> level_{spdlog::level::off};
+  std::atomic<uint64_t> dropped_{0};
+  std::unique_ptr<State> state_;
+};
+
+// Renders a file written with DeferredLogOptions::binary_path, one line
+// per record; returns false if it is truncated or malformed
+bool decode_deferred_log(std::istream& in, std::ostream& out);
+
+// Deferred counterparts of LOG_*; the same SEEDLIB_ACTIVE_LEVEL applies.
+// The "" prefix makes anything but a literal format string fail to compile.
+#define SEEDLIB_DEFERRED_CALL(level, ...)                                     \
+    do {                                                                       \
+        if (::seedlib::DeferredLog::instance().should_log(level)) {            \
+            ::seedlib::DeferredLog::instance().log(level, "" __VA_ARGS__);     \
+        }                                                                      \
+    } while (0)
+
+#if SEEDLIB_ACTIVE_LEVEL <= 1
+#define LOG_DEFERRED_DEBUG(...) SEEDLIB_DEFERRED_CALL(::spdlog::level::debug, __VA_ARGS__)
+#else
+#define LOG_DEFERRED_DEBUG(...) ((void)0)
+#endif
+
+#if SEEDLIB_ACTIVE_LEVEL <= 2
+#define LOG_DEFERRED_INFO(...) SEEDLIB_DEFERRED_CALL(::spdlog::level::info, __VA_ARGS__)
+#else
+#define LOG_DEFERRED_INFO(...) ((void)0)
+#endif
+
+#if SEEDLIB_ACTIVE_LEVEL <= 3
+#define LOG_DEFERRED_WARN(...) SEEDLIB_DEFERRED_CALL(::spdlog::level::warn, __VA_ARGS__)
+#else
+#define LOG_DEFERRED_WARN(...) ((void)0)
+#endif
+
+#if SEEDLIB_ACTIVE_LEVEL <= 4
+#define LOG_DEFERRED_ERROR(...) SEEDLIB_DEFERRED_CALL(::spdlog::level::err, __VA_ARGS__)
+#else
+#define LOG_DEFERRED_ERROR(...) ((void)0)
+#endif
+
+} // namespace seedlib
+
+#endif
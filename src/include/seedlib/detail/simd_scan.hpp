@@ -0,0 +1,52 @@
+// src/include/seedlib/detail/simd_scan.hpp (internal; public only for SEEDLIB_HEADER_ONLY)
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+namespace seedlib::simd {
+
+// Returns the first byte in [first, last) equal to a or b, or last.
+// Scans 16-32 bytes per step using the widest instruction set the CPU
+// supports (AVX2, SSE2 or NEON), falling back to a scalar loop.
+const char* find_either(const char* first, const char* last, char a, char b) noexcept;
+
+// Returns the first byte in [first, last) equal to c, or last
+inline const char* find_byte(const char* first, const char* last, char c) noexcept {
+    const void* hit = std::memchr(first, c, static_cast<size_t>(last - first));
+    return hit ? static_cast<const char*>(hit) : last;
+}
+
+// A set of ASCII bytes in the form a byte shuffle can test 16 or 32 at a
+// time: c is in the set when low[c & 15] & high[c >> 4] is nonzero. Bytes
+// 0x80 and above are never in it.
+struct ByteClass {
+    uint8_t low[16];
+    uint8_t high[16];
+
+    constexpr bool contains(char c) const noexcept {
+        const auto u = static_cast<unsigned char>(c);
+        return (low[u & 15] & high[u >> 4]) != 0;
+    }
+};
+
+// The class of the ASCII bytes for which in(c) holds
+template <typename Predicate>
+constexpr ByteClass make_byte_class(Predicate in) {
+    ByteClass result{};
+    for (unsigned h = 0; h < 8; ++h) {
+        result.high[h] = static_cast<uint8_t>(1u << h);
+        for (unsigned l = 0; l < 16; ++l) {
+            if (in(static_cast<char>(h << 4 | l))) result.low[l] |= static_cast<uint8_t>(1u << h);
+        }
+    }
+    return result;
+}
+
+// Returns the first byte in [first, last) that is neither in allowed nor
+// the '%' of a well-formed %XX escape, or last; a '%' there is the start
+// of a malformed escape. allowed must contain the hex digits, which are
+// then covered without skipping them. Classes and escapes are checked a
+// whole vector at a time (AVX2 or SSSE3), with a scalar loop elsewhere.
+const char* skip_escaped(const char* first, const char* last, const ByteClass& allowed) noexcept;
+
+} // namespace seedlib::simd
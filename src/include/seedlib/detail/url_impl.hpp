@@ -0,0 +1,80 @@
+// src/include/seedlib/detail/url_impl.hpp (internal; public only for SEEDLIB_HEADER_ONLY)
+#pragma once
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <type_traits>
+#include "seedlib/host_interner.hpp"
+#include "seedlib/url.hpp"
+
+namespace seedlib {
+
+// Owning URL storage in a single allocation: a fixed header of component
+// offsets, followed directly by the component text packed back to back.
+// The header is trivially copyable, so copying a URL is one memcpy.
+class URLImpl {
+public:
+    // In text order
+    enum Component : uint8_t { kScheme, kHost, kPath, kQuery, kFragment, kComponentCount };
+
+    struct Span {
+        uint32_t offset{0};
+        uint32_t length{0};
+    };
+
+    // Single forward scan over the input; never throws
+    static bool scan(std::string_view url, URLView& view, URLError& error) noexcept;
+
+    // With an interner the host is referenced from its pool, not copied.
+    // A null resource means the global heap.
+    static URLImpl* create(const URLView& view, HostInterner* interner = nullptr,
+                           std::pmr::memory_resource* resource = nullptr);
+    static URLImpl* clone(const URLImpl& other);
+    static void destroy(URLImpl* impl) noexcept;
+
+    // Replaces one component's text. Patches the buffer in place when the
+    // result fits; otherwise returns a new, larger copy (the caller frees
+    // the old one).
+    static URLImpl* replace(URLImpl* impl, Component component, std::string_view value);
+
+    // Same, for erase bytes at pos within the component (pos == length
+    // appends)
+    static URLImpl* splice(URLImpl* impl, Component component, uint32_t pos, uint32_t erase,
+                           std::string_view value);
+
+    std::string_view get(Component component) const {
+        return {text() + spans[component].offset, spans[component].length};
+    }
+
+    char* data(Component component) { return text() + spans[component].offset; }
+
+    std::string_view host() const {
+        return interned_host.data() ? interned_host : get(kHost);
+    }
+
+    // Registered schemes keep no text, only their id
+    std::string_view scheme() const {
+        return scheme_id != SchemeId::unknown ? scheme_info(scheme_id).name : get(kScheme);
+    }
+
+    uint32_t capacity{0};  // Bytes of text storage after the header
+    uint32_t size{0};      // Bytes of text in use
+    Span spans[kComponentCount];
+    uint16_t port{0};
+    SchemeId scheme_id{SchemeId::unknown};
+    IPAddress host_address;  // Decoded IP literal; kind classifies the host
+    std::string_view interned_host;  // Set when the kHost span is unused
+    std::pmr::memory_resource* resource{nullptr};  // Where this block came from
+
+private:
+    URLImpl() = default;
+
+    static URLImpl* allocate(size_t text_size, std::pmr::memory_resource* resource);
+
+    char* text() { return reinterpret_cast<char*>(this + 1); }
+    const char* text() const { return reinterpret_cast<const char*>(this + 1); }
+};
+
+static_assert(std::is_trivially_copyable_v<URLImpl>);
+
+} // namespace seedlib
@@ -0,0 +1,256 @@
+// src/include/seedlib/detail/url_inline.hpp
+//
+// The scanner, view parsing and the URL getters. With SEEDLIB_HEADER_ONLY
+// url.hpp includes this, so every caller inlines them past the pimpl;
+// otherwise url.cpp includes it once and they are ordinary out-of-line
+// definitions. Either way there is one copy of the source.
+#ifndef SEEDLIB_DETAIL_URL_INLINE_HPP
+#define SEEDLIB_DETAIL_URL_INLINE_HPP
+
+#include "seedlib/url.hpp"
+#include "seedlib/metrics.hpp"
+#include "seedlib/detail/simd_scan.hpp"
+#include "seedlib/detail/url_impl.hpp"
+#include <array>
+
+#if SEEDLIB_HEADER_ONLY
+#define SEEDLIB_URL_INLINE inline
+#else
+#define SEEDLIB_URL_INLINE
+#endif
+
+namespace seedlib {
+
+namespace detail::url_chars {
+    // Character classes from RFC 3986 Appendix A, used by the scanner
+    enum CharClass : uint8_t {
+        kAlpha        = 1 << 0,
+        kDigit        = 1 << 1,
+        kHexDigit     = 1 << 2,
+        kSchemeExtra  = 1 << 3,  // "+" / "-" / "."
+        kRegName      = 1 << 4,  // unreserved / sub-delims / "%"
+        kAuthorityEnd = 1 << 5,  // "/" / "?" / "#"
+    };
+
+    constexpr std::array<uint8_t, 256> make_char_table() {
+        std::array<uint8_t, 256> table{};
+        for (int c = 'a'; c <= 'z'; ++c) table[c] |= kAlpha | kRegName;
+        for (int c = 'A'; c <= 'Z'; ++c) table[c] |= kAlpha | kRegName;
+        for (int c = '0'; c <= '9'; ++c) table[c] |= kDigit | kHexDigit | kRegName;
+        for (int c = 'a'; c <= 'f'; ++c) table[c] |= kHexDigit;
+        for (int c = 'A'; c <= 'F'; ++c) table[c] |= kHexDigit;
+        for (unsigned char c : std::string_view("+-.")) table[c] |= kSchemeExtra;
+        for (unsigned char c : std::string_view("-._~!$&'()*+,;=%")) table[c] |= kRegName;
+        for (unsigned char c : std::string_view("/?#")) table[c] |= kAuthorityEnd;
+        return table;
+    }
+
+    inline constexpr auto char_table = make_char_table();
+
+    inline bool has_class(char c, uint8_t classes) {
+        return (char_table[static_cast<unsigned char>(c)] & classes) != 0;
+    }
+
+    // Checks a reg-name or bracketed IPv6 literal and decodes IP hosts into
+    // address; returns the offending character, or nullptr if well-formed
+    inline const char* check_host(const char* first, const char* last, IPAddress& address) {
+        address = IPAddress{};
+        if (first == last) {
+            return nullptr;
+        }
+
+        if (*first == '[') {
+            if (last - first < 3 || last[-1] != ']') {
+                return first;
+            }
+            address.kind = HostKind::ipv6;
+            const std::string_view literal(first + 1, static_cast<size_t>(last - first - 2));
+            return parse_ipv6(literal, address.bytes) ? nullptr : first + 1;
+        }
+
+        for (const char* p = first; p != last; ++p) {
+            if (!has_class(*p, kRegName)) {
+                return p;
+            }
+        }
+
+        // Dotted numbers that are not a valid IPv4address stay a reg-name
+        std::array<uint8_t, 4> v4;
+        if (has_class(last[-1], kDigit) &&
+            parse_ipv4(std::string_view(first, static_cast<size_t>(last - first)), v4)) {
+            address.kind = HostKind::ipv4;
+            std::copy(v4.begin(), v4.end(), address.bytes.begin());
+        } else {
+            address.kind = HostKind::domain;
+        }
+        return nullptr;
+    }
+
+    // Parser counters: every scan, the bytes scanned, and failures by error
+    // code. Registered once during static initialization (url.cpp), so the
+    // noexcept scan only bumps them; a scan that runs earlier, or a failed
+    // registration, counts into the detached sink instead.
+    struct ParserMetrics {
+        static constexpr size_t kCodes = static_cast<size_t>(URLErrc::invalid_percent_encoding) + 1;
+
+        metrics::Counter parses;
+        metrics::Counter bytes;
+        metrics::Counter errors[kCodes];
+
+        ParserMetrics() noexcept;
+    };
+
+    extern const ParserMetrics parser_metrics;
+} // namespace detail::url_chars
+
+// Finds all component boundaries in one forward pass:
+//   scheme ":" [ "//" [ userinfo "@" ] host [ ":" port ] ] path [ "?" query ] [ "#" fragment ]
+SEEDLIB_URL_INLINE bool URLImpl::scan(std::string_view url, URLView& view, URLError& error) noexcept {
+    using namespace detail::url_chars;
+    const char* const begin = url.data();
+    const char* const end = begin + url.size();
+    const char* p = begin;
+    const ParserMetrics& counters = parser_metrics;
+    counters.parses.add();
+    counters.bytes.add(url.size());
+    auto fail = [&](URLErrc code, const char* where) {
+        counters.errors[static_cast<size_t>(code)].add();
+        view = URLView{};
+        error.code = code;
+        error.offset = static_cast<uint32_t>(where - begin);
+        return false;
+    };
+    auto span = [begin](const char* first, const char* last) {
+        return URLView::Span{static_cast<uint32_t>(first - begin),
+                             static_cast<uint32_t>(last - first)};
+    };
+
+    if (url.size() > UINT32_MAX) {
+        counters.errors[static_cast<size_t>(URLErrc::too_long)].add();
+        view = URLView{};
+        error = URLError{URLErrc::too_long, UINT32_MAX};
+        return false;
+    }
+
+    view = URLView{};
+    view.data_ = begin;
+
+    // scheme = ALPHA *( ALPHA / DIGIT / "+" / "-" / "." )
+    while (p != end && has_class(*p, kAlpha | kDigit | kSchemeExtra)) ++p;
+    if (p == begin || p == end || *p != ':') {
+        return fail(URLErrc::invalid_format, p);
+    }
+    if (!has_class(*begin, kAlpha)) {
+        return fail(URLErrc::invalid_scheme, begin);
+    }
+    view.scheme_ = span(begin, p);
+    view.scheme_id_ = lookup_scheme(view.scheme());
+    ++p;
+
+    // Parse authority component (user:pass@host:port)
+    if (end - p >= 2 && p[0] == '/' && p[1] == '/') {
+        p += 2;
+        const char* host_begin = p;
+        const char* port_colon = nullptr;
+        bool in_brackets = false;
+
+        for (; p != end && !has_class(*p, kAuthorityEnd); ++p) {
+            switch (*p) {
+            case '@':  // everything so far was userinfo
+                host_begin = p + 1;
+                port_colon = nullptr;
+                in_brackets = false;
+                break;
+            case '[':
+                in_brackets = true;
+                break;
+            case ']':
+                in_brackets = false;
+                break;
+            case ':':
+                if (!in_brackets) port_colon = p;
+                break;
+            default:
+                break;
+            }
+        }
+
+        const char* host_end = port_colon ? port_colon : p;
+        if (host_begin == host_end) {
+            if (view.scheme_id_ != SchemeId::file) {
+                return fail(URLErrc::invalid_authority, host_begin);
+            }
+        } else if (const char* bad = check_host(host_begin, host_end, view.host_address_)) {
+            return fail(URLErrc::invalid_host, bad);
+        }
+        view.host_ = span(host_begin, host_end);
+
+        if (port_colon && port_colon + 1 != p) {
+            uint32_t value = 0;
+            for (const char* q = port_colon + 1; q != p; ++q) {
+                if (!has_class(*q, kDigit)) {
+                    return fail(URLErrc::invalid_port, q);
+                }
+                value = value * 10 + static_cast<uint32_t>(*q - '0');
+                if (value > 65535) {
+                    return fail(URLErrc::port_out_of_range, port_colon + 1);
+                }
+            }
+            view.port_ = static_cast<uint16_t>(value);
+        } else {
+            view.port_ = scheme_info(view.scheme_id_).default_port;
+        }
+    }
+
+    // Path and query can run to kilobytes, so their delimiters are found
+    // with vector compares rather than byte by byte
+    const char* path_begin = p;
+    p = simd::find_either(p, end, '?', '#');
+    view.path_ = span(path_begin, p);
+
+    if (p != end && *p == '?') {
+        const char* query_begin = ++p;
+        p = simd::find_byte(p, end, '#');
+        view.query_ = span(query_begin, p);
+    }
+
+    if (p != end) {
+        view.fragment_ = span(p + 1, end);
+    }
+
+    error = URLError{};
+    return true;
+}
+
+// URLView parsing
+SEEDLIB_URL_INLINE std::optional<URLView> URLView::try_parse(std::string_view url, URLError& error) noexcept {
+    URLView view;
+    if (!URLImpl::scan(url, view, error)) {
+        return std::nullopt;
+    }
+    return view;
+}
+
+SEEDLIB_URL_INLINE std::optional<URLView> URLView::parse(std::string_view url) noexcept {
+    URLError error;
+    return try_parse(url, error);
+}
+
+// Getters
+SEEDLIB_URL_INLINE std::string_view URL::scheme() const { return impl_->scheme(); }
+SEEDLIB_URL_INLINE std::string_view URL::host() const { return impl_->host(); }
+SEEDLIB_URL_INLINE uint16_t URL::port() const { return impl_->port; }
+SEEDLIB_URL_INLINE SchemeId URL::scheme_id() const { return impl_->scheme_id; }
+SEEDLIB_URL_INLINE HostKind URL::host_kind() const { return impl_->host_address.kind; }
+SEEDLIB_URL_INLINE std::optional<IPAddress> URL::ip_address() const {
+    if (impl_->host_address.size() == 0) return std::nullopt;
+    return impl_->host_address;
+}
+SEEDLIB_URL_INLINE std::string_view URL::path() const { return impl_->get(URLImpl::kPath); }
+SEEDLIB_URL_INLINE std::string_view URL::query() const { return impl_->get(URLImpl::kQuery); }
+SEEDLIB_URL_INLINE std::string_view URL::fragment() const { return impl_->get(URLImpl::kFragment); }
+SEEDLIB_URL_INLINE QueryParams URL::query_params() const { return QueryParams(query()); }
+
+} // namespace seedlib
+
+#endif
@@ -0,0 +1,39 @@
+// src/include/seedlib/host.hpp
+
+#ifndef HOST_HPP
+#define HOST_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace seedlib {
+
+enum class HostKind : uint8_t {
+  none = 0,  // Empty host, as in "file:///etc/hosts"
+  domain,    // Registered name, including dotted numbers that are not IPv4
+  ipv4,
+  ipv6,      // Bracketed literal
+};
+
+// Binary form of an IP literal host, in network byte order
+struct IPAddress {
+  HostKind kind{HostKind::none};
+  std::array<uint8_t, 16> bytes{};  // IPv4 uses the first 4
+
+  size_t size() const noexcept {
+    return kind == HostKind::ipv4 ? 4 : kind == HostKind::ipv6 ? 16 : 0;
+  }
+};
+
+// RFC 3986 IPv4address: exactly four decimal octets, no leading zeros
+bool parse_ipv4(std::string_view text, std::array<uint8_t, 4>& out) noexcept;
+
+// RFC 4291 2.2 text forms without the brackets: eight groups, one "::"
+// compression, and an optional trailing dotted IPv4. Zone IDs are rejected.
+bool parse_ipv6(std::string_view text, std::array<uint8_t, 16>& out) noexcept;
+
+} // namespace seedlib
+
+#endif
@@ -0,0 +1,48 @@
+// src/include/seedlib/host_interner.hpp
+
+#ifndef HOST_INTERNER_HPP
+#define HOST_INTERNER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace seedlib {
+
+// Thread-safe pool of host strings. Each distinct text is stored once, in
+// arena blocks that are only released with the interner, so the returned
+// views stay valid (and compare equal by data pointer) for its lifetime.
+//
+// Lookups are lock-free: shards are open-addressed tables of atomic entry
+// pointers, and a growing table is published with a release store while
+// the old one is kept for readers still probing it. Only inserting a new
+// host takes the shard's mutex.
+class HostInterner {
+public:
+  explicit HostInterner(size_t shard_count = 16);  // Rounded up to a power of two
+  ~HostInterner();
+
+  HostInterner(const HostInterner&) = delete;
+  HostInterner& operator=(const HostInterner&) = delete;
+
+  // Stable copy of text, inserting it on first use
+  std::string_view intern(std::string_view text);
+
+  // The interned copy, or a view with null data if text was never interned
+  std::string_view find(std::string_view text) const noexcept;
+
+  size_t size() const noexcept;            // Distinct strings
+  size_t bytes_reserved() const noexcept;  // Arena block bytes
+
+private:
+  struct Shard;
+
+  Shard& shard_for(size_t hash) const noexcept;
+
+  std::unique_ptr<Shard[]> shards_;
+  size_t shard_mask_;
+};
+
+} // namespace seedlib
+
+#endif
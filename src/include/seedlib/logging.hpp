@@ -8,50 +8,128 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include "seedlib/logging_config.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// LOG_* calls below this level (an spdlog::level number) compile to
+// nothing, arguments included. Defaults to the configured level for the
+// build type; define it before the first include to override.
+#ifndef SEEDLIB_ACTIVE_LEVEL
+#define SEEDLIB_ACTIVE_LEVEL DEFAULT_LOG_LEVEL_VALUE
+#endif
+
+// When 1, LOG_METRIC records into seedlib::metrics histograms instead of
+// writing a log line. Defaults to LOG_METRICS_TO_REGISTRY; define it
+// before the first include to override.
+#ifndef SEEDLIB_METRICS_ROUTE
+#define SEEDLIB_METRICS_ROUTE LOG_METRICS_TO_REGISTRY
+#endif
+
+#if SEEDLIB_METRICS_ROUTE
+#include "seedlib/metrics.hpp"
+#endif
 
 namespace seedlib {
 
+// Key/value pair for structured fields and metric tags; the text only has
+// to live for the duration of the call
+using LogField = std::pair<std::string_view, std::string_view>;
+
+namespace detail {
+    // "10MB" style sizes as used by LOG_MAX_SIZE; a bare number is bytes
+    constexpr size_t parse_log_size(std::string_view text) {
+        size_t value = 0;
+        size_t i = 0;
+        for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {
+            value = value * 10 + static_cast<size_t>(text[i] - '0');
+        }
+        const std::string_view unit = text.substr(i);
+        if (unit == "KB" || unit == "K") return value << 10;
+        if (unit == "MB" || unit == "M") return value << 20;
+        if (unit == "GB" || unit == "G") return value << 30;
+        return value;
+    }
+}
+
+// Runtime settings for Logger::init; every default is the CMake value
+struct LoggingOptions {
+    std::string app_name = "seedlib";
+
+    bool console = ENABLE_CONSOLE_LOGGING;
+    std::string console_pattern = LOG_CONSOLE_PATTERN;
+
+    bool file = ENABLE_FILE_LOGGING;
+    std::string file_path = LOG_FILE_PATH;
+    std::string file_pattern = LOG_FILE_PATTERN;
+    size_t max_file_size = detail::parse_log_size(LOG_MAX_SIZE);
+    size_t max_files = LOG_MAX_FILES;
+
+    bool async = ENABLE_ASYNC_LOGGING;
+    size_t queue_size = LOG_QUEUE_SIZE;
+    size_t worker_threads = LOG_THREAD_COUNT;
+    // A full queue overwrites its oldest message and counts it (see
+    // Logger::dropped) rather than stalling the caller on slow sinks
+    spdlog::async_overflow_policy overflow = spdlog::async_overflow_policy::overrun_oldest;
+
+    // Periodic flush of every registered logger; zero disables it
+    std::chrono::milliseconds flush_interval{LOG_FLUSH_INTERVAL_MS};
+
+    // Added after the console and file sinks, e.g. a custom backend. The
+    // logger's sink list is fixed once init returns, as spdlog does not
+    // lock it against concurrent logging.
+    std::vector<spdlog::sink_ptr> extra_sinks;
+};
+
 class Logger {
 public:
+    // A constant-initialized static, so there is no guard check per call
     static Logger& instance() {
-        static Logger logger;
-        return logger;
+        return instance_;
     }
 
-    void init(const std::string& app_name = "seedlib") {
+    void init(const LoggingOptions& options = {}) {
         try {
-            // Create sinks
-            auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
-            console_sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%n] [%^%l%$] [%t] %v");
-
-            std::vector<spdlog::sink_ptr> sinks{console_sink};
-
-            #ifdef ENABLE_FILE_LOGGING
-            auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
-                "logs/" + app_name + ".log",
-                1024 * 1024 * 10,  // 10MB max file size
-                3                   // Keep 3 rotated files
-            );
-            file_sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%n] [%l] [%t] %v");
-            sinks.push_back(file_sink);
-            #endif
+            std::vector<spdlog::sink_ptr> sinks;
 
-            #ifdef ENABLE_ASYNC_LOGGING
-            spdlog::init_thread_pool(8192, 1);
-            logger_ = std::make_shared<spdlog::async_logger>(
-                app_name,
-                sinks.begin(),
-                sinks.end(),
-                spdlog::thread_pool(),
-                spdlog::async_overflow_policy::block
-            );
-            #else
-            logger_ = std::make_shared<spdlog::logger>(app_name, sinks.begin(), sinks.end());
-            #endif
+            if (options.console) {
+                auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+                console_sink->set_pattern(options.console_pattern);
+                sinks.push_back(console_sink);
+            }
+
+            if (options.file) {
+                auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
+                    options.file_path, options.max_file_size, options.max_files);
+                file_sink->set_pattern(options.file_pattern);
+                sinks.push_back(file_sink);
+            }
+
+            sinks.insert(sinks.end(), options.extra_sinks.begin(), options.extra_sinks.end());
 
-            #ifdef ENABLE_DEBUG_LOGGING
+            if (options.async) {
+                spdlog::init_thread_pool(options.queue_size, options.worker_threads);
+                logger_ = std::make_shared<spdlog::async_logger>(
+                    options.app_name,
+                    sinks.begin(),
+                    sinks.end(),
+                    spdlog::thread_pool(),
+                    options.overflow
+                );
+            } else {
+                logger_ = std::make_shared<spdlog::logger>(options.app_name, sinks.begin(), sinks.end());
+            }
+
+            #if ENABLE_DEBUG_LOGGING
             logger_->set_level(spdlog::level::debug);
             logger_->flush_on(spdlog::level::debug);
             #else
@@ -59,8 +137,15 @@ public:
             logger_->flush_on(spdlog::level::err);
             #endif
 
+            spdlog::drop(options.app_name);
             spdlog::register_logger(logger_);
             spdlog::set_default_logger(logger_);
+            if (options.flush_interval.count() > 0) {
+                // Older spdlog releases only flush in whole seconds
+                spdlog::flush_every(std::chrono::ceil<std::chrono::seconds>(options.flush_interval));
+            }
+            async_ = options.async;
+            level_.store(logger_->level(), std::memory_order_relaxed);
 
         } catch (const spdlog::spdlog_ex& ex) {
             std::cerr << "Logger initialization failed: " << ex.what() << std::endl;
@@ -68,6 +153,34 @@ public:
         }
     }
 
+    void init(const std::string& app_name) {
+        LoggingOptions options;
+        options.app_name = app_name;
+        init(options);
+    }
+
+    // Adopts an existing spdlog logger, e.g. one with custom sinks
+    void init(std::shared_ptr<spdlog::logger> logger) {
+        logger_ = std::move(logger);
+        async_ = false;
+        level_.store(logger_->level(), std::memory_order_relaxed);
+    }
+
+    void set_level(spdlog::level::level_enum level) {
+        logger_->set_level(level);
+        level_.store(level, std::memory_order_relaxed);
+    }
+
+    // Messages the async queue has overwritten under overrun_oldest
+    size_t dropped() const {
+        return async_ ? spdlog::thread_pool()->overrun_counter() : 0;
+    }
+
+    // One relaxed load; false for every level until init() has run
+    bool should_log(spdlog::level::level_enum level) const noexcept {
+        return level >= level_.load(std::memory_order_relaxed);
+    }
+
     template<typename... Args>
     void debug(fmt::format_string<Args...> fmt, Args&&... args) {
         logger_->debug(fmt, std::forward<Args>(args)...);
@@ -88,49 +201,175 @@ public:
         logger_->error(fmt, std::forward<Args>(args)...);
     }
 
-    // Structured logging support
+    // Structured logging support. Fields given as a braced list of
+    // string_view pairs cost no allocation beyond spdlog's own:
+    //   LOG_INFO("user_login", {{"user_id", id}, {"ip", ip}}, "User logged in");
+    template<typename... Args>
+    void debug(std::string_view event_name, std::initializer_list<LogField> fields,
+               fmt::format_string<Args...> fmt, Args&&... args) {
+        log_structured(spdlog::level::debug, event_name, fields, fmt, std::forward<Args>(args)...);
+    }
+
     template<typename... Args>
-    void debug(const std::string& event_name, const std::unordered_map<std::string, std::string>& fields,
+    void info(std::string_view event_name, std::initializer_list<LogField> fields,
+              fmt::format_string<Args...> fmt, Args&&... args) {
+        log_structured(spdlog::level::info, event_name, fields, fmt, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void warn(std::string_view event_name, std::initializer_list<LogField> fields,
+              fmt::format_string<Args...> fmt, Args&&... args) {
+        log_structured(spdlog::level::warn, event_name, fields, fmt, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void error(std::string_view event_name, std::initializer_list<LogField> fields,
+               fmt::format_string<Args...> fmt, Args&&... args) {
+        log_structured(spdlog::level::err, event_name, fields, fmt, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void debug(std::string_view event_name, const std::unordered_map<std::string, std::string>& fields,
                fmt::format_string<Args...> fmt, Args&&... args) {
         log_structured(spdlog::level::debug, event_name, fields, fmt, std::forward<Args>(args)...);
     }
 
     // Log metrics
-    void metric(const std::string& metric_name, double value,
-                const std::unordered_map<std::string, std::string>& tags = {}) {
-        std::string tag_str;
-        for (const auto& [key, val] : tags) {
-            tag_str += fmt::format("{}={},", key, val);
-        }
-        if (!tag_str.empty()) {
-            tag_str.pop_back(); // Remove trailing comma
-        }
-        logger_->info("METRIC {} value={} {}", metric_name, value, tag_str);
+    void metric(std::string_view metric_name, double value, std::initializer_list<LogField> tags = {}) {
+        log_metric(metric_name, value, tags);
+    }
+
+    void metric(std::string_view metric_name, double value,
+                const std::unordered_map<std::string, std::string>& tags) {
+        log_metric(metric_name, value, tags);
+    }
+
+    // Tags as alternating keys and values, the values of any formattable
+    // type, so numbers need no conversion to text first:
+    //   LOG_METRIC("request_duration_ms", 42.3, "endpoint", path, "status", 200);
+    template<typename Value, typename... Rest>
+    void metric(std::string_view metric_name, double value, std::string_view key, const Value& tag,
+                const Rest&... rest) {
+        static_assert(sizeof...(Rest) % 2 == 0, "metric tags come in key/value pairs");
+        if (!logger_->should_log(spdlog::level::info)) return;
+        fmt::memory_buffer line;
+        begin_metric(line, metric_name, value);
+        append_tags(line, key, tag, rest...);
+        logger_->log(spdlog::level::info, spdlog::string_view_t(line.data(), line.size()));
     }
 
 private:
-    Logger() = default;
+    constexpr Logger() = default;
+    static Logger instance_;
+
     std::shared_ptr<spdlog::logger> logger_;
+    std::atomic<int> level_{spdlog::level::off};
+    bool async_{false};
 
-    template<typename... Args>
-    void log_structured(spdlog::level::level_enum level, const std::string& event_name,
-                       const std::unordered_map<std::string, std::string>& fields,
-                       fmt::format_string<Args...> fmt, Args&&... args) {
-        std::string field_str;
+    static void append(fmt::memory_buffer& line, std::string_view text) {
+        line.append(text.data(), text.data() + text.size());
+    }
+
+    static void begin_metric(fmt::memory_buffer& line, std::string_view metric_name, double value) {
+        append(line, "METRIC ");
+        append(line, metric_name);
+        append(line, " value=");
+        fmt::format_to(std::back_inserter(line), "{}", value);
+        line.push_back(' ');
+    }
+
+    template<typename Value, typename... Rest>
+    static void append_tags(fmt::memory_buffer& line, std::string_view key, const Value& value,
+                            const Rest&... rest) {
+        append(line, key);
+        line.push_back('=');
+        fmt::format_to(std::back_inserter(line), "{}", value);
+        if constexpr (sizeof...(Rest) != 0) {
+            line.push_back(',');
+            append_tags(line, rest...);
+        }
+    }
+
+    // Each line is formatted into one stack buffer (500 bytes before it
+    // spills to the heap) and handed to spdlog in a single call
+    template<typename Tags>
+    void log_metric(std::string_view metric_name, double value, const Tags& tags) {
+        if (!logger_->should_log(spdlog::level::info)) return;
+        fmt::memory_buffer line;
+        begin_metric(line, metric_name, value);
+        bool first = true;
+        for (const auto& [key, tag] : tags) {
+            if (!first) line.push_back(',');
+            first = false;
+            append(line, key);
+            line.push_back('=');
+            append(line, tag);
+        }
+        logger_->log(spdlog::level::info, spdlog::string_view_t(line.data(), line.size()));
+    }
+
+    template<typename Fields, typename... Args>
+    void log_structured(spdlog::level::level_enum level, std::string_view event_name, const Fields& fields,
+                        fmt::format_string<Args...> fmt, Args&&... args) {
+        if (!logger_->should_log(level)) return;
+        fmt::memory_buffer line;
+        append(line, "event=");
+        append(line, event_name);
+        line.push_back(' ');
         for (const auto& [key, value] : fields) {
-            field_str += fmt::format("{}={} ", key, value);
+            append(line, key);
+            line.push_back('=');
+            append(line, value);
+            line.push_back(' ');
         }
-        logger_->log(level, "event={} {} {}", event_name, field_str,
-                    fmt::format(fmt, std::forward<Args>(args)...));
+        line.push_back(' ');
+        fmt::format_to(std::back_inserter(line), fmt, std::forward<Args>(args)...);
+        logger_->log(level, spdlog::string_view_t(line.data(), line.size()));
     }
 };
 
-// Convenience macros
-#define LOG_DEBUG(...) ::seedlib::Logger::instance().debug(__VA_ARGS__)
-#define LOG_INFO(...) ::seedlib::Logger::instance().info(__VA_ARGS__)
-#define LOG_WARN(...) ::seedlib::Logger::instance().warn(__VA_ARGS__)
-#define LOG_ERROR(...) ::seedlib::Logger::instance().error(__VA_ARGS__)
-#define LOG_METRIC(...) ::seedlib::Logger::instance().metric(__VA_ARGS__)
+inline Logger Logger::instance_;
+
+// Convenience macros. Enabled levels check the runtime level before any
+// argument is evaluated or formatted.
+#define SEEDLIB_LOG_CALL(level, method, ...)                                   \
+    do {                                                                       \
+        if (::seedlib::Logger::instance().should_log(level)) {                 \
+            ::seedlib::Logger::instance().method(__VA_ARGS__);                 \
+        }                                                                      \
+    } while (0)
+
+#if SEEDLIB_ACTIVE_LEVEL <= 1
+#define LOG_DEBUG(...) SEEDLIB_LOG_CALL(::spdlog::level::debug, debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if SEEDLIB_ACTIVE_LEVEL <= 2
+#define LOG_INFO(...) SEEDLIB_LOG_CALL(::spdlog::level::info, info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if SEEDLIB_ACTIVE_LEVEL <= 3
+#define LOG_WARN(...) SEEDLIB_LOG_CALL(::spdlog::level::warn, warn, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if SEEDLIB_ACTIVE_LEVEL <= 4
+#define LOG_ERROR(...) SEEDLIB_LOG_CALL(::spdlog::level::err, error, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+// Metrics are data rather than diagnostics, so only the runtime level
+// applies to them
+#if SEEDLIB_METRICS_ROUTE
+#define LOG_METRIC(...) ::seedlib::metrics::record(__VA_ARGS__)
+#else
+#define LOG_METRIC(...) SEEDLIB_LOG_CALL(::spdlog::level::info, metric, __VA_ARGS__)
+#endif
 
 } // namespace seedlib
 
@@ -0,0 +1,235 @@
+// src/include/seedlib/metrics.hpp
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <spdlog/fmt/fmt.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// In-process counters, gauges and latency histograms, aggregated on read.
+//
+// Registration by name is a locked map lookup, so hot code registers once
+// and keeps the handle. Counter and histogram updates then go to a block
+// owned by the calling thread, a plain relaxed load and store with no
+// lock prefix and no shared cache lines. Readers sum the blocks of every
+// thread. A block outlives its thread and is handed to the next new
+// thread, so totals never go backwards.
+namespace seedlib::metrics {
+
+using Label = std::pair<std::string_view, std::string_view>;
+
+namespace detail {
+  constexpr size_t kMaxCounters = 1024;    // Counter series per process
+  constexpr size_t kMaxHistograms = 128;   // Histogram series per process
+  constexpr size_t kMaxGauges = 256;
+
+  // HDR-style log-linear buckets: values below 16 are exact, then each
+  // power of two is split into 16, so a bucket is within 1/16 of its
+  // values. Values of 2^48 and above share the last bucket.
+  constexpr unsigned kSubBucketBits = 4;
+  constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+  constexpr unsigned kMaxBit = 47;
+  constexpr size_t kBuckets = (kMaxBit - kSubBucketBits + 2) * kSubBuckets;
+
+  constexpr size_t bucket_index(uint64_t value) noexcept {
+    if (value < kSubBuckets) return static_cast<size_t>(value);
+    unsigned bit = 63 - static_cast<unsigned>(__builtin_clzll(value));
+    if (bit > kMaxBit) return kBuckets - 1;
+    const unsigned shift = bit - kSubBucketBits;
+    return (shift + 1) * kSubBuckets + static_cast<size_t>((value >> shift) - kSubBuckets);
+  }
+
+  // Largest value that lands in bucket index
+  constexpr uint64_t bucket_upper(size_t index) noexcept {
+    if (index < kSubBuckets) return index;
+    const size_t shift = index / kSubBuckets - 1;
+    const uint64_t lower = (kSubBuckets + index % kSubBuckets) << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+  }
+
+  // One thread's histogram; only that thread writes it
+  struct HistogramCells {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> max{0};
+    std::atomic<uint64_t> buckets[kBuckets] = {};
+  };
+
+  struct alignas(64) ThreadBlock {
+    std::atomic<uint64_t> counters[kMaxCounters] = {};
+    std::atomic<HistogramCells*> histograms[kMaxHistograms] = {};
+    std::atomic<bool> in_use{false};
+    ThreadBlock* next{nullptr};  // Every block ever handed out
+  };
+
+  inline thread_local ThreadBlock* thread_block = nullptr;
+
+  // Recycles or allocates the calling thread's block. Never fails: if
+  // allocation does, the thread shares a fallback block and may lose the
+  // odd update to a racing thread.
+  ThreadBlock* attach_thread() noexcept;
+  HistogramCells* attach_histogram(ThreadBlock& block, uint32_t id) noexcept;
+
+  inline ThreadBlock& block() noexcept {
+    ThreadBlock* b = thread_block;
+    return b ? *b : *attach_thread();
+  }
+
+  // Single-writer increment: no read-modify-write instruction needed
+  inline void bump(std::atomic<uint64_t>& cell, uint64_t n) noexcept {
+    cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  // Renders labels as {key="value",...}, escaped for Prometheus
+  void append_label(fmt::memory_buffer& out, std::string_view key, std::string_view value);
+  void close_labels(fmt::memory_buffer& out);
+  void record_rendered(std::string_view name, std::string_view labels, double value);
+}
+
+// Monotonic count
+class Counter {
+public:
+  Counter() = default;  // Detached; updates land on a shared sink cell
+
+  void add(uint64_t n = 1) const noexcept { detail::bump(detail::block().counters[id_], n); }
+  uint64_t value() const noexcept;
+
+private:
+  friend Counter counter(std::string_view, std::initializer_list<Label>);
+  explicit Counter(uint32_t id) : id_(id) {}
+  uint32_t id_{0};
+};
+
+// Last value set. Gauges are levels rather than sums, so they are one
+// shared atomic instead of per-thread cells.
+class Gauge {
+public:
+  Gauge() = default;
+
+  void set(double value) const noexcept;
+  void add(double delta) const noexcept;
+  double value() const noexcept;
+
+private:
+  friend Gauge gauge(std::string_view, std::initializer_list<Label>);
+  explicit Gauge(uint32_t id) : id_(id) {}
+  uint32_t id_{0};
+};
+
+struct HistogramSnapshot {
+  uint64_t count{0};
+  uint64_t sum{0};
+  uint64_t max{0};
+  std::vector<uint64_t> buckets;  // detail::kBuckets counts, or empty
+
+  // Upper bound of the bucket holding quantile q (0..1), capped at max
+  uint64_t percentile(double q) const noexcept;
+  double mean() const noexcept { return count ? static_cast<double>(sum) / count : 0.0; }
+};
+
+// Distribution of non-negative integers, e.g. latencies in nanoseconds
+class Histogram {
+public:
+  Histogram() = default;
+
+  void record(uint64_t value) const noexcept {
+    detail::ThreadBlock& b = detail::block();
+    detail::HistogramCells* cells = b.histograms[id_].load(std::memory_order_relaxed);
+    if (!cells && !(cells = detail::attach_histogram(b, id_))) return;
+    detail::bump(cells->buckets[detail::bucket_index(value)], 1);
+    detail::bump(cells->count, 1);
+    detail::bump(cells->sum, value);
+    if (value > cells->max.load(std::memory_order_relaxed)) cells->max.store(value, std::memory_order_relaxed);
+  }
+
+  // Records value * scale, rounded; reports divide it back out
+  void observe(double value) const noexcept {
+    const double scaled = value * scale_ + 0.5;
+    record(scaled <= 0 ? 0 : scaled >= 1.8e19 ? UINT64_MAX : static_cast<uint64_t>(scaled));
+  }
+
+  HistogramSnapshot snapshot() const;
+  double scale() const noexcept { return scale_; }
+
+private:
+  friend Histogram histogram(std::string_view, std::initializer_list<Label>, double);
+  friend void detail::record_rendered(std::string_view, std::string_view, double);
+  Histogram(uint32_t id, double scale) : id_(id), scale_(scale) {}
+  uint32_t id_{0};
+  double scale_{1.0};
+};
+
+// Registration: the same name and labels always return the same series.
+// Throws std::invalid_argument if the name is already another kind of
+// metric, and std::length_error once the kind's series limit is reached.
+Counter counter(std::string_view name, std::initializer_list<Label> labels = {});
+Gauge gauge(std::string_view name, std::initializer_list<Label> labels = {});
+// scale converts observe() values to the recorded integers, e.g. 1000 to
+// keep milliseconds to the microsecond
+Histogram histogram(std::string_view name, std::initializer_list<Label> labels = {}, double scale = 1.0);
+
+// Every series on one line:
+//   name=V name{k="v"}=V hist{count=N,mean=M,p50=A,p90=B,p99=C,max=D}
+std::string summary();
+
+// Prometheus text exposition format; histograms are written as summaries
+// with 0.5, 0.9 and 0.99 quantiles
+std::string prometheus();
+
+// Logs summary() at info every interval on a background thread, once the
+// Logger is initialized. Calling it again changes the interval.
+void start_reporting(std::chrono::milliseconds interval);
+void start_reporting();  // LOG_FLUSH_INTERVAL_MS
+void stop_reporting();
+
+// LOG_METRIC-compatible recording into a histogram named name with the
+// tags as labels, scaled by 1000; see SEEDLIB_METRICS_ROUTE in logging.hpp
+inline void record(std::string_view name, double value, std::initializer_list<Label> tags = {}) {
+  fmt::memory_buffer labels;
+  for (const auto& [key, tag] : tags) detail::append_label(labels, key, tag);
+  detail::close_labels(labels);
+  detail::record_rendered(name, std::string_view(labels.data(), labels.size()), value);
+}
+
+inline void record(std::string_view name, double value, const std::unordered_map<std::string, std::string>& tags) {
+  fmt::memory_buffer labels;
+  for (const auto& [key, tag] : tags) detail::append_label(labels, key, tag);
+  detail::close_labels(labels);
+  detail::record_rendered(name, std::string_view(labels.data(), labels.size()), value);
+}
+
+template <typename Value, typename... Rest>
+void record(std::string_view name, double value, std::string_view key, const Value& tag, const Rest&... rest) {
+  static_assert(sizeof...(Rest) % 2 == 0, "metric tags come in key/value pairs");
+  fmt::memory_buffer labels;
+  fmt::memory_buffer text;
+  auto one = [&](std::string_view k, const auto& v) {
+    text.clear();
+    fmt::format_to(std::back_inserter(text), "{}", v);
+    detail::append_label(labels, k, std::string_view(text.data(), text.size()));
+  };
+  one(key, tag);
+  if constexpr (sizeof...(Rest) != 0) {
+    auto pairs = [&](auto&& self, std::string_view k, const auto& v, const auto&... more) -> void {
+      one(k, v);
+      if constexpr (sizeof...(more) != 0) self(self, more...);
+    };
+    pairs(pairs, rest...);
+  }
+  detail::close_labels(labels);
+  detail::record_rendered(name, std::string_view(labels.data(), labels.size()), value);
+}
+
+} // namespace seedlib::metrics
+
+#endif
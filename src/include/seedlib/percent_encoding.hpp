@@ -0,0 +1,62 @@
+// src/include/seedlib/percent_encoding.hpp
+
+#ifndef PERCENT_ENCODING_HPP
+#define PERCENT_ENCODING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace seedlib {
+
+// How '+' is treated: form decoding (query strings) turns it into a space
+enum class PercentDecodeMode : uint8_t {
+  component,
+  form,
+};
+
+struct PercentDecodeResult {
+  size_t size{0};          // Bytes written to the output
+  size_t error_offset{0};  // Input offset of the first malformed escape
+  bool ok{true};
+
+  explicit operator bool() const noexcept { return ok; }
+};
+
+// True if the input contains anything percent_decode would change
+bool needs_percent_decode(std::string_view input,
+                          PercentDecodeMode mode = PercentDecodeMode::form) noexcept;
+
+// Decodes into out, which must hold at least input.size() bytes. Stops at
+// the first malformed escape ("%" not followed by two hex digits) and
+// reports its offset; bytes before it are already written.
+PercentDecodeResult percent_decode(std::string_view input, char* out,
+                                   PercentDecodeMode mode = PercentDecodeMode::form) noexcept;
+
+// Decodes in place; on success the decoded text is data[0, result.size)
+PercentDecodeResult percent_decode_in_place(char* data, size_t size,
+                                            PercentDecodeMode mode = PercentDecodeMode::form) noexcept;
+
+// Appends input to out, percent-encoding every byte outside the RFC 3986
+// unreserved set; form mode writes spaces as "+"
+void percent_encode(std::string_view input, std::string& out,
+                    PercentDecodeMode mode = PercentDecodeMode::form);
+
+// True if encoded decodes to exactly decoded, without writing the result
+// anywhere. Malformed escapes compare as their literal text.
+bool percent_decoded_equals(std::string_view encoded, std::string_view decoded,
+                            PercentDecodeMode mode = PercentDecodeMode::form) noexcept;
+
+// Decodes in place and shrinks the string; it is left unchanged on failure
+PercentDecodeResult percent_decode_in_place(std::string& text,
+                                            PercentDecodeMode mode = PercentDecodeMode::form);
+
+// Decodes in place, keeping malformed escapes as their literal text (as
+// percent_decoded_equals compares them) and decoding everything around
+// them; it cannot fail
+void percent_decode_lenient(std::string& text, PercentDecodeMode mode = PercentDecodeMode::form);
+
+} // namespace seedlib
+
+#endif
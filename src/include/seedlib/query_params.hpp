@@ -0,0 +1,104 @@
+// src/include/seedlib/query_params.hpp
+
+#ifndef QUERY_PARAMS_HPP
+#define QUERY_PARAMS_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace seedlib {
+
+// One key=value pair from a query string, still percent-encoded
+struct QueryParam {
+  std::string_view key;
+  std::string_view value;  // Empty when the pair has no "="
+
+  // Form-decoded copies; malformed escapes are kept verbatim
+  std::string decoded_key() const;
+  std::string decoded_value() const;
+};
+
+// Lazy view over the "&"-separated pairs of a query string. Pairs come out
+// in order, duplicates included, and nothing is decoded unless asked for.
+// Empty segments ("a=1&&b=2") are skipped.
+class QueryParams {
+public:
+  class iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = QueryParam;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const QueryParam*;
+    using reference = const QueryParam&;
+
+    iterator() = default;
+
+    reference operator*() const { return current_; }
+    pointer operator->() const { return &current_; }
+
+    iterator& operator++() {
+      advance();
+      return *this;
+    }
+
+    iterator operator++(int) {
+      iterator previous = *this;
+      advance();
+      return previous;
+    }
+
+    friend bool operator==(const iterator& a, const iterator& b) { return a.pos_ == b.pos_; }
+    friend bool operator!=(const iterator& a, const iterator& b) { return a.pos_ != b.pos_; }
+
+  private:
+    friend class QueryParams;
+
+    iterator(const char* pos, const char* end) : next_(pos), end_(end) { advance(); }
+
+    void advance() {
+      while (next_ != end_ && *next_ == '&') ++next_;
+      pos_ = next_;
+      if (pos_ == end_) {
+        pos_ = nullptr;
+        return;
+      }
+
+      const void* amp = std::memchr(pos_, '&', static_cast<size_t>(end_ - pos_));
+      next_ = amp ? static_cast<const char*>(amp) : end_;
+
+      std::string_view pair(pos_, static_cast<size_t>(next_ - pos_));
+      auto eq = pair.find('=');
+      current_.key = pair.substr(0, eq);
+      current_.value = eq == std::string_view::npos ? std::string_view() : pair.substr(eq + 1);
+    }
+
+    const char* pos_{nullptr};  // Start of the current pair; nullptr at end
+    const char* next_{nullptr};
+    const char* end_{nullptr};
+    QueryParam current_;
+  };
+
+  QueryParams() = default;
+  explicit QueryParams(std::string_view query) : query_(query) {}
+
+  iterator begin() const { return iterator(query_.data(), query_.data() + query_.size()); }
+  iterator end() const { return iterator(); }
+  bool empty() const { return begin() == end(); }
+
+  // First pair whose decoded key equals key; stops at the first match and
+  // compares without materializing the decoded key
+  std::optional<QueryParam> find(std::string_view key) const noexcept;
+
+  std::string_view raw() const { return query_; }
+
+private:
+  std::string_view query_;
+};
+
+} // namespace seedlib
+
+#endif
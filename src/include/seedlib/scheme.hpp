@@ -0,0 +1,149 @@
+// src/include/seedlib/scheme.hpp
+
+#ifndef SCHEME_HPP
+#define SCHEME_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace seedlib {
+
+// Built-in schemes; URLs store this one byte instead of the scheme text
+enum class SchemeId : uint8_t {
+  unknown = 0,
+  http,
+  https,
+  ws,
+  wss,
+  ftp,
+  file,
+};
+
+struct SchemeInfo {
+  std::string_view name;
+  SchemeId id;
+  uint16_t default_port;  // 0 if the scheme has none
+  bool secure;
+  bool special;  // WHATWG special scheme: hierarchical, host-based
+};
+
+// Indexed by SchemeId
+inline constexpr SchemeInfo scheme_table[] = {
+  {"", SchemeId::unknown, 0, false, false},
+  {"http", SchemeId::http, 80, false, true},
+  {"https", SchemeId::https, 443, true, true},
+  {"ws", SchemeId::ws, 80, false, true},
+  {"wss", SchemeId::wss, 443, true, true},
+  {"ftp", SchemeId::ftp, 21, false, true},
+  {"file", SchemeId::file, 0, false, true},
+};
+
+constexpr const SchemeInfo& scheme_info(SchemeId id) noexcept {
+  return scheme_table[static_cast<size_t>(id)];
+}
+
+namespace detail {
+  constexpr char ascii_lower(char c) noexcept {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+  }
+
+  // b must already be lowercase
+  constexpr bool iequals(std::string_view a, std::string_view b) noexcept {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+      if (ascii_lower(a[i]) != b[i]) return false;
+    }
+    return true;
+  }
+}
+
+// Case-insensitive lookup. Length and first letter select at most one
+// candidate, so a lookup is one switch plus one short compare.
+constexpr SchemeId lookup_scheme(std::string_view name) noexcept {
+  if (name.empty()) return SchemeId::unknown;
+
+  const char first = detail::ascii_lower(name[0]);
+  SchemeId candidate = SchemeId::unknown;
+  switch (name.size()) {
+  case 2:
+    if (first == 'w') candidate = SchemeId::ws;
+    break;
+  case 3:
+    if (first == 'w') candidate = SchemeId::wss;
+    else if (first == 'f') candidate = SchemeId::ftp;
+    break;
+  case 4:
+    if (first == 'h') candidate = SchemeId::http;
+    else if (first == 'f') candidate = SchemeId::file;
+    break;
+  case 5:
+    if (first == 'h') candidate = SchemeId::https;
+    break;
+  default:
+    break;
+  }
+
+  if (candidate != SchemeId::unknown && detail::iequals(name, scheme_info(candidate).name)) {
+    return candidate;
+  }
+  return SchemeId::unknown;
+}
+
+namespace detail {
+  constexpr bool scheme_table_is_consistent() noexcept {
+    for (size_t i = 1; i < sizeof(scheme_table) / sizeof(scheme_table[0]); ++i) {
+      if (static_cast<size_t>(scheme_table[i].id) != i) return false;
+      if (lookup_scheme(scheme_table[i].name) != scheme_table[i].id) return false;
+    }
+    return true;
+  }
+}
+
+static_assert(detail::scheme_table_is_consistent(),
+              "scheme_table order or lookup_scheme switch is out of sync");
+
+// Compile-time extension point. Specialize for a tag type with a constexpr
+// array of extra entries, names in lowercase (their id stays
+// SchemeId::unknown):
+//
+//   struct MySchemes;
+//   template <> struct scheme_extension<MySchemes> {
+//     static constexpr SchemeInfo entries[] = {{"gopher", SchemeId::unknown, 70, false, false}};
+//   };
+//   constexpr auto* info = SchemeRegistry<MySchemes>::find("gopher");
+//
+// URL parsing itself only consults the built-in table.
+template <typename Tag>
+struct scheme_extension {
+  static constexpr SchemeInfo entries[] = {{"", SchemeId::unknown, 0, false, false}};
+};
+
+template <typename Tag = void>
+struct SchemeRegistry {
+  static constexpr const SchemeInfo* find(std::string_view name) noexcept {
+    if (SchemeId id = lookup_scheme(name); id != SchemeId::unknown) {
+      return &scheme_info(id);
+    }
+    for (const auto& entry : scheme_extension<Tag>::entries) {
+      if (!entry.name.empty() && detail::iequals(name, entry.name)) return &entry;
+    }
+    return nullptr;
+  }
+
+  // Walks the tables directly rather than testing find()'s pointer, which
+  // GCC rejects in constant expressions under -fsanitize=undefined
+  static constexpr uint16_t default_port(std::string_view name) noexcept {
+    if (SchemeId id = lookup_scheme(name); id != SchemeId::unknown) {
+      return scheme_info(id).default_port;
+    }
+    for (const auto& entry : scheme_extension<Tag>::entries) {
+      if (!entry.name.empty() && detail::iequals(name, entry.name)) return entry.default_port;
+    }
+    return 0;
+  }
+};
+
+} // namespace seedlib
+
+#endif
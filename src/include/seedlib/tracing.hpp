@@ -0,0 +1,114 @@
+// src/include/seedlib/tracing.hpp
+
+#ifndef TRACING_HPP
+#define TRACING_HPP
+
+#include "seedlib/metrics.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// SEEDLIB_TRACE_SPAN sites are compiled in only when this is 1; otherwise
+// they expand to nothing. The runtime below is always available.
+#ifndef SEEDLIB_ENABLE_TRACING
+#define SEEDLIB_ENABLE_TRACING 0
+#endif
+
+// Scoped timers for seedlib's own hot paths. Each finished span records
+// its duration in nanoseconds into the seedlib_span_ns{span="..."}
+// histogram, and while a capture is running it is also kept as a Chrome
+// trace event (chrome://tracing, Perfetto).
+namespace seedlib::tracing {
+
+// Raw timestamp: the TSC on x86 (invariant on anything recent), steady_clock
+// ticks elsewhere
+inline uint64_t ticks() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Measured against steady_clock on first use
+double ns_per_tick() noexcept;
+
+namespace detail {
+  inline std::atomic<bool> capturing{false};
+  void capture(const char* name, uint64_t start, uint64_t end) noexcept;
+}
+
+// Per call site state, created once; name must be a string literal.
+// Construction never throws, so spans can sit in noexcept functions.
+class SpanSite {
+public:
+  explicit SpanSite(const char* name) noexcept
+      : name_(name), histogram_(span_histogram(name)), ns_per_tick_(ns_per_tick()) {}
+
+  void finish(uint64_t start, uint64_t end) const noexcept {
+    histogram_.record(static_cast<uint64_t>(static_cast<double>(end - start) * ns_per_tick_));
+    if (detail::capturing.load(std::memory_order_relaxed)) detail::capture(name_, start, end);
+  }
+
+  const char* name() const noexcept { return name_; }
+
+private:
+  // A site the registry has no room for records into the detached
+  // histogram; capture still works
+  static metrics::Histogram span_histogram(const char* name) noexcept {
+    try {
+      return metrics::histogram("seedlib_span_ns", {{"span", name}});
+    } catch (...) {
+      return {};
+    }
+  }
+
+  const char* name_;
+  metrics::Histogram histogram_;
+  double ns_per_tick_;
+};
+
+class ScopedSpan {
+public:
+  explicit ScopedSpan(const SpanSite& site) noexcept : site_(site), start_(ticks()) {}
+  ~ScopedSpan() { site_.finish(start_, ticks()); }
+
+  ScopedSpan(const ScopedSpan&) = delete;
+  ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+  const SpanSite& site_;
+  uint64_t start_;
+};
+
+// Keeps finished spans from every thread, up to max_events, until
+// stop_capture(); starting again discards the previous capture
+void start_capture(size_t max_events = size_t{1} << 20);
+void stop_capture();
+
+// The captured spans as Chrome trace-event JSON ("X" events, times in
+// microseconds from the first capture); returns how many were written
+size_t write_chrome_trace(std::ostream& out);
+
+} // namespace seedlib::tracing
+
+#define SEEDLIB_TRACE_CONCAT_(a, b) a##b
+#define SEEDLIB_TRACE_CONCAT(a, b) SEEDLIB_TRACE_CONCAT_(a, b)
+
+// Times the rest of the enclosing scope as span name
+#if SEEDLIB_ENABLE_TRACING
+#define SEEDLIB_TRACE_SPAN(name)                                                               \
+    static const ::seedlib::tracing::SpanSite SEEDLIB_TRACE_CONCAT(seedlib_span_site_, __LINE__){name}; \
+    const ::seedlib::tracing::ScopedSpan SEEDLIB_TRACE_CONCAT(seedlib_span_, __LINE__){        \
+        SEEDLIB_TRACE_CONCAT(seedlib_span_site_, __LINE__)}
+#else
+#define SEEDLIB_TRACE_SPAN(name) ((void)0)
+#endif
+
+#endif
@@ -3,27 +3,109 @@
 #ifndef URL_HPP
 #define URL_HPP
 
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <optional>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "seedlib/arena.hpp"
+#include "seedlib/host.hpp"
+#include "seedlib/query_params.hpp"
+#include "seedlib/scheme.hpp"
+
+// With SEEDLIB_HEADER_ONLY the scanner, URLView parsing and the URL getters
+// are defined inline by this header (see detail/url_inline.hpp) rather
+// than in url.cpp. The library must be built with the same setting.
+#ifndef SEEDLIB_HEADER_ONLY
+#define SEEDLIB_HEADER_ONLY 0
+#endif
 
 namespace seedlib {
 
 // Forward declaration of implementation
 class URLImpl;
+class URLView;
+class HostInterner;
+
+// Failure categories reported by the non-throwing parse path
+enum class URLErrc : uint8_t {
+  ok = 0,
+  invalid_format,
+  invalid_scheme,
+  invalid_authority,
+  invalid_host,
+  invalid_port,
+  port_out_of_range,
+  too_long,
+  invalid_userinfo,
+  invalid_path,
+  invalid_query,
+  invalid_fragment,
+  invalid_percent_encoding,
+};
+
+// Grammar URL::check() and URL::validate() hold a URL to
+enum class ValidationProfile : uint8_t {
+  // RFC 3986 Appendix A, every component and escape checked, plus the
+  // scheme rules parse() applies; anything valid here parses
+  rfc3986,
+  // Fails only where the WHATWG URL parser would (leading and trailing
+  // spaces, backslashes and stray characters are accepted)
+  whatwg,
+};
+
+// Options for URL::normalize() and URL::canonical_hash()
+struct NormalizeOptions {
+  bool sort_query = false;  // Stable-sort query pairs by key
+};
+
+struct URLError {
+  URLErrc code{URLErrc::ok};
+  uint32_t offset{0};  // Byte offset of the failure in the input
+
+  const char* message() const noexcept;
+  explicit operator bool() const noexcept { return code != URLErrc::ok; }
+};
 
 class URL {
 public:
   // Constructors that might fail should use factory methods
   static std::optional<URL> parse(std::string_view url);
 
+  // Never throws on malformed input; the failure is reported through error
+  static std::optional<URL> try_parse(std::string_view url, URLError& error);
+
+  // Hosts are taken from the interner instead of being copied into each
+  // URL, so they share storage and compare equal by host().data(). The
+  // interner must outlive the URL; set_host() and normalize() detach.
+  static std::optional<URL> parse(std::string_view url, HostInterner& interner);
+  static std::optional<URL> try_parse(std::string_view url, URLError& error,
+                                      HostInterner& interner);
+
+  // Storage comes from resource rather than the global heap; the URL must
+  // not outlive it. Edits that outgrow the block reallocate from the same
+  // resource, while copies go to the global heap as with std::pmr types.
+  static std::optional<URL> parse(std::string_view url, std::pmr::memory_resource* resource);
+  static std::optional<URL> try_parse(std::string_view url, URLError& error,
+                                      std::pmr::memory_resource* resource);
+  static std::optional<URL> parse(std::string_view url, Arena& arena);
+
+  // Accept/reject without building a URL: no allocation, and the scan
+  // stops at the first violation
+  static URLError check(std::string_view url,
+                        ValidationProfile profile = ValidationProfile::rfc3986) noexcept;
+
   // Validation with reason
   struct ValidationResult {
     bool valid;
     std::string reason;
   };
-  static ValidationResult validate(std::string_view url);
+  static ValidationResult validate(std::string_view url,
+                                   ValidationProfile profile = ValidationProfile::rfc3986);
 
   // Getters for components
   std::string_view scheme() const;
@@ -32,15 +114,82 @@ public:
   std::string_view path() const;
   std::string_view query() const;
   std::string_view fragment() const;
+  SchemeId scheme_id() const;  // SchemeId::unknown for unregistered schemes
 
-  // Modification methods
+  // Host classification from parsing; IP literals are decoded to binary
+  HostKind host_kind() const;
+  std::optional<IPAddress> ip_address() const;
+
+  // Lazy (key, value) pairs of the query, in order and still encoded
+  QueryParams query_params() const;
+
+  // Modification methods. Switching between a special scheme (see
+  // SchemeInfo) and a non-special one is rejected, as in the WHATWG setter.
   void set_scheme(std::string_view scheme);
   void set_port(uint16_t port);
 
+  // Component setters patch the stored text in place when it fits and
+  // throw URLValidationError for values that would not round-trip
+  void set_host(std::string_view host);
+  void set_path(std::string_view path);          // Empty means "/"
+  void set_query(std::string_view query);        // Without the leading "?"
+  void set_fragment(std::string_view fragment);  // Without the leading "#"
+
+  // Appends key=value to the query, form-encoding both
+  void append_query_param(std::string_view key, std::string_view value);
+
   // Utility methods
   std::string to_string() const;
   bool is_secure() const;  // checks if scheme is https or wss
 
+  // RFC 3986 5.2 reference resolution with this URL as the base. The
+  // target is assembled in one buffer (on the stack unless it is large)
+  // with dot segments removed in place, then scanned once.
+  std::optional<URL> resolve(std::string_view ref) const;
+  std::optional<URL> try_resolve(std::string_view ref, URLError& error) const;
+
+  // Resolves every ref against this base, gathering the base's parts once
+  std::vector<std::optional<URL>> resolve(const std::vector<std::string_view>& refs) const;
+
+  // RFC 3986 6.2.2 normalization in place: lowercases the host, resolves
+  // "." and ".." segments, uppercases percent-escapes and decodes escaped
+  // unreserved characters. Default ports are already omitted on output.
+  void normalize(const NormalizeOptions& options = {});
+
+  // 64-bit hash of the normalized form, computed without building it;
+  // equal URLs after normalize() hash equal
+  uint64_t canonical_hash(const NormalizeOptions& options = {}) const;
+
+  // Serialize without a temporary string
+  void append_to(std::string& out) const;
+
+  template <typename OutputIt>
+  OutputIt format_to(OutputIt out) const {
+    auto put = [&out](std::string_view text) {
+      for (char c : text) *out++ = c;
+    };
+    char port_buffer[5];
+    const std::string_view port = port_text(port_buffer);
+
+    put(scheme());
+    put("://");
+    put(host());
+    if (!port.empty()) {
+      *out++ = ':';
+      put(port);
+    }
+    put(path());
+    if (!query().empty()) {
+      *out++ = '?';
+      put(query());
+    }
+    if (!fragment().empty()) {
+      *out++ = '#';
+      put(fragment());
+    }
+    return out;
+  }
+
   // Rule of 5
   URL(URL&& other) noexcept;
   URL& operator=(URL&& other) noexcept;
@@ -49,11 +198,80 @@ public:
   ~URL();
 
 private:
+  friend class URLView;
+
+  // Replaces one URLImpl::Component, moving to a larger block if needed
+  void patch(uint8_t component, std::string_view value);
+
+  // Port digits for serialization; empty when it is the scheme default
+  std::string_view port_text(char (&buffer)[5]) const;
+
+  // URLImpl lives in one custom-sized allocation
+  struct ImplDeleter {
+    void operator()(URLImpl* impl) const noexcept;
+  };
+
   // Private constructor used by factory method
-  explicit URL(std::unique_ptr<URLImpl> impl);
-  std::unique_ptr<URLImpl> impl_;
+  explicit URL(URLImpl* impl);
+  std::unique_ptr<URLImpl, ImplDeleter> impl_;
 };
 
+// Non-owning parse result: component offsets into the caller's buffer.
+// Parsing a view does not allocate, except that a thread's first metrics
+// update (its first parse, if nothing else came before) allocates that
+// thread's metrics block of about 9 KB, or reuses one freed by an exited
+// thread. The buffer must outlive the view.
+class URLView {
+public:
+  static std::optional<URLView> parse(std::string_view url) noexcept;
+  static std::optional<URLView> try_parse(std::string_view url, URLError& error) noexcept;
+
+  URLView() = default;
+
+  // Getters for components (scheme is returned as written, not lowercased)
+  std::string_view scheme() const { return slice(scheme_); }
+  std::string_view host() const { return slice(host_); }
+  uint16_t port() const { return port_; }  // Returns 0 if not specified
+  std::string_view path() const { return path_.length ? slice(path_) : "/"; }
+  std::string_view query() const { return slice(query_); }
+  std::string_view fragment() const { return slice(fragment_); }
+  SchemeId scheme_id() const { return scheme_id_; }
+  HostKind host_kind() const { return host_address_.kind; }
+  std::optional<IPAddress> ip_address() const {
+    if (host_address_.size() == 0) return std::nullopt;
+    return host_address_;
+  }
+  QueryParams query_params() const { return QueryParams(query()); }
+
+  // Copies the components into an owning URL
+  URL to_owned() const;
+  URL to_owned(HostInterner& interner) const;
+  URL to_owned(std::pmr::memory_resource* resource) const;
+
+private:
+  friend class URLImpl;
+  friend class URLBatch;
+
+  struct Span {
+    uint32_t offset{0};
+    uint32_t length{0};
+  };
+
+  std::string_view slice(Span span) const { return {data_ + span.offset, span.length}; }
+
+  const char* data_{nullptr};
+  Span scheme_;
+  Span host_;
+  Span path_;
+  Span query_;
+  Span fragment_;
+  uint16_t port_{0};
+  SchemeId scheme_id_{SchemeId::unknown};
+  IPAddress host_address_;
+};
+
+static_assert(std::is_trivially_copyable_v<URLView>);
+
 // Domain-specific exceptions
 class URLParseError : public std::runtime_error {
   using std::runtime_error::runtime_error;
@@ -65,4 +283,8 @@ class URLValidationError : public std::runtime_error {
 
 } // namespace seedlib
 
+#if SEEDLIB_HEADER_ONLY
+#include "seedlib/detail/url_inline.hpp"
+#endif
+
 #endif
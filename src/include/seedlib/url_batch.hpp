@@ -0,0 +1,123 @@
+// src/include/seedlib/url_batch.hpp
+
+#ifndef URL_BATCH_HPP
+#define URL_BATCH_HPP
+
+#include "seedlib/url.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+namespace seedlib {
+
+// Columnar result of parse_batch. Row i describes input i; component
+// columns hold offsets into that input, so the input buffers must outlive
+// the batch. Reusing one batch across calls keeps parsing allocation-free
+// once its columns have grown to the working batch size.
+class URLBatch {
+public:
+  struct Span {
+    uint32_t offset{0};
+    uint32_t length{0};
+  };
+
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  void clear() noexcept { size_ = 0; }
+
+  bool valid(size_t i) const noexcept { return (valid_bits_[i / 64] >> (i % 64)) & 1u; }
+  size_t valid_count() const noexcept;
+  URLErrc error(size_t i) const noexcept { return errors_[i]; }
+
+  // Row accessors; only meaningful for valid rows
+  URLView view(size_t i) const noexcept;
+  std::string_view host(size_t i) const noexcept { return slice(i, hosts_[i]); }
+  std::string_view path(size_t i) const noexcept;
+
+  // Columns, one element per row
+  const std::vector<SchemeId>& scheme_ids() const noexcept { return scheme_ids_; }
+  const std::vector<uint16_t>& ports() const noexcept { return ports_; }
+  const std::vector<Span>& schemes() const noexcept { return schemes_; }
+  const std::vector<Span>& hosts() const noexcept { return hosts_; }
+  const std::vector<IPAddress>& host_addresses() const noexcept { return host_addresses_; }
+  const std::vector<Span>& paths() const noexcept { return paths_; }
+  const std::vector<Span>& queries() const noexcept { return queries_; }
+  const std::vector<Span>& fragments() const noexcept { return fragments_; }
+  const std::vector<URLErrc>& errors() const noexcept { return errors_; }
+
+  // Validity bitmap, 64 rows per word
+  const std::vector<uint64_t>& valid_bits() const noexcept { return valid_bits_; }
+
+private:
+  friend void parse_batch(const std::string_view* urls, size_t count, URLBatch& out,
+                          unsigned threads);
+
+  std::string_view slice(size_t i, Span span) const noexcept {
+    return {bases_[i] + span.offset, span.length};
+  }
+
+  void resize(size_t count);
+  void store(size_t i, const URLView& view);
+
+  size_t size_{0};
+  std::vector<const char*> bases_;
+  std::vector<SchemeId> scheme_ids_;
+  std::vector<uint16_t> ports_;
+  std::vector<Span> schemes_;
+  std::vector<Span> hosts_;
+  std::vector<IPAddress> host_addresses_;
+  std::vector<Span> paths_;
+  std::vector<Span> queries_;
+  std::vector<Span> fragments_;
+  std::vector<URLErrc> errors_;
+  std::vector<uint64_t> valid_bits_;
+};
+
+// Parses count URLs into out, reusing its storage
+void parse_batch(const std::string_view* urls, size_t count, URLBatch& out);
+
+// Splits the input across up to `threads` threads (the caller included),
+// with work stealing between them. Row results are identical to the
+// single-threaded overload.
+void parse_batch(const std::string_view* urls, size_t count, URLBatch& out, unsigned threads);
+
+inline void parse_batch(const std::vector<std::string_view>& urls, URLBatch& out) {
+  parse_batch(urls.data(), urls.size(), out);
+}
+
+inline void parse_batch(const std::vector<std::string_view>& urls, URLBatch& out,
+                        unsigned threads) {
+  parse_batch(urls.data(), urls.size(), out, threads);
+}
+
+inline URLBatch parse_batch(const std::vector<std::string_view>& urls) {
+  URLBatch batch;
+  parse_batch(urls.data(), urls.size(), batch);
+  return batch;
+}
+
+#if __cplusplus >= 202002L
+inline void parse_batch(std::span<const std::string_view> urls, URLBatch& out) {
+  parse_batch(urls.data(), urls.size(), out);
+}
+
+inline void parse_batch(std::span<const std::string_view> urls, URLBatch& out,
+                        unsigned threads) {
+  parse_batch(urls.data(), urls.size(), out, threads);
+}
+
+inline URLBatch parse_batch(std::span<const std::string_view> urls) {
+  URLBatch batch;
+  parse_batch(urls.data(), urls.size(), batch);
+  return batch;
+}
+#endif
+
+} // namespace seedlib
+
+#endif
@@ -0,0 +1,64 @@
+// src/include/seedlib/url_cache.hpp
+
+#ifndef URL_CACHE_HPP
+#define URL_CACHE_HPP
+
+#include "seedlib/url.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace seedlib {
+
+struct URLCacheStats {
+  uint64_t hits{0};
+  uint64_t misses{0};
+  uint64_t evictions{0};
+  uint64_t rejected{0};  // Invalid inputs, which are never cached
+  size_t size{0};
+};
+
+// Memoizing parser for skewed traffic, keyed by the raw input text.
+// Entries are shared immutable URLs, so a hit is a reference-count bump.
+//
+// The cache is split into independently locked shards, each a fixed ring
+// of slots evicted by CLOCK (second chance). Hits take the shard lock
+// shared and only set the slot's reference bit; misses parse outside the
+// lock and then insert exclusively.
+class URLCache {
+public:
+  explicit URLCache(size_t capacity = 4096, size_t shard_count = 16);
+  ~URLCache();
+
+  URLCache(const URLCache&) = delete;
+  URLCache& operator=(const URLCache&) = delete;
+
+  // Cached parse; nullptr if url is invalid
+  std::shared_ptr<const URL> parse(std::string_view url);
+
+  // Lookup without parsing on a miss
+  std::shared_ptr<const URL> find(std::string_view url) const;
+
+  void clear();
+
+  size_t capacity() const noexcept { return capacity_; }
+  URLCacheStats stats() const noexcept;
+
+  // Emits the counters with LOG_METRIC as <prefix>.hits, .misses, ...;
+  // the Logger must already be initialized
+  void report_metrics(const std::string& prefix = "url_cache") const;
+
+private:
+  struct Shard;
+
+  Shard& shard_for(size_t hash) const noexcept;
+
+  std::unique_ptr<Shard[]> shards_;
+  size_t shard_mask_;
+  size_t capacity_;
+};
+
+} // namespace seedlib
+
+#endif
@@ -0,0 +1,113 @@
+// src/include/seedlib/url_matcher.hpp
+
+#ifndef URL_MATCHER_HPP
+#define URL_MATCHER_HPP
+
+#include "seedlib/scheme.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace seedlib {
+
+class URL;
+class URLView;
+
+// Rules to compile into a URLMatcher. A pattern is
+//
+//   [scheme://]host[/path]
+//
+// where host is a name matched without case ("example.com"), "*." and a
+// name for any subdomain of it but not the name itself ("*.example.com"),
+// or "*" for any host. The path is matched segment by segment and exactly,
+// unless its last segment is "*", which matches the segments before it
+// and anything below them: "/api/v2/*" matches "/api/v2", "/api/v2/" and
+// "/api/v2/users". Without a path any path matches. Ports, queries and
+// fragments are not considered.
+//
+// Several patterns may share a rule id, e.g. all the hosts of one route.
+class URLRuleSet {
+public:
+  // Throws std::invalid_argument for a malformed pattern
+  void add(std::string_view pattern, uint32_t id);
+
+  size_t size() const noexcept { return rules_.size(); }
+  bool empty() const noexcept { return rules_.empty(); }
+  void clear() noexcept { rules_.clear(); }
+
+private:
+  friend class URLMatcher;
+
+  struct Rule {
+    uint32_t id;
+    SchemeId scheme;  // unknown for any scheme
+    bool any_subdomain;
+    bool any_path_below;
+    std::vector<std::string> host_labels;  // Lowercase, last label first
+    std::vector<std::string> path_segments;
+  };
+
+  std::vector<Rule> rules_;
+};
+
+// Rule ids matching a URL, found in time proportional to the URL's length
+// rather than the number of rules. Rules compile into two levels of flat
+// tries: a trie of reversed host labels (com -> example -> www), whose
+// nodes lead to radix tries of path segments, with single-child chains
+// collapsed into one edge.
+//
+// Matching is lock-free and reload() swaps in a new rule set while other
+// threads match. The matcher keeps two compiled sets; readers announce
+// the one they use in per-thread-striped counters, and a reload waits
+// only for readers still on the set before last, which it then replaces.
+class URLMatcher {
+public:
+  URLMatcher();
+  explicit URLMatcher(const URLRuleSet& rules);
+  ~URLMatcher();
+
+  URLMatcher(const URLMatcher&) = delete;
+  URLMatcher& operator=(const URLMatcher&) = delete;
+
+  // Compiles rules and publishes them; matches already running finish on
+  // the previous set. Reloads are serialized with each other.
+  void reload(const URLRuleSet& rules);
+
+  // Ascending, distinct ids of the matching rules
+  std::vector<uint32_t> match(const URLView& url) const;
+  std::vector<uint32_t> match(const URL& url) const;
+
+  // Same, into out (cleared first), so a reused vector does not allocate
+  void match(const URLView& url, std::vector<uint32_t>& out) const;
+  void match(const URL& url, std::vector<uint32_t>& out) const;
+
+  // Patterns in the current rule set
+  size_t size() const noexcept;
+
+private:
+  struct Compiled;
+  class ReadGuard;
+
+  static constexpr size_t kStripes = 16;
+
+  struct alignas(64) ReaderCount {
+    std::atomic<uint32_t> value{0};
+  };
+
+  void match(SchemeId scheme, std::string_view host, std::string_view path, std::vector<uint32_t>& out) const;
+
+  std::unique_ptr<const Compiled> sets_[2];
+  std::atomic<unsigned> current_{0};
+  mutable std::array<ReaderCount, kStripes> readers_[2];
+  std::mutex reload_mutex_;
+};
+
+} // namespace seedlib
+
+#endif
@@ -0,0 +1,93 @@
+// src/include/seedlib/url_store.hpp
+
+#ifndef URL_STORE_HPP
+#define URL_STORE_HPP
+
+#include "seedlib/scheme.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace seedlib {
+
+class URLBatch;
+class URLView;
+
+struct URLStoreOptions {
+  bool wal{true};                       // journal_mode=WAL with synchronous=NORMAL
+  size_t rows_per_transaction{100000};  // Batch inserts commit every this many rows; 0 for one transaction
+  int busy_timeout_ms{5000};            // Wait on another connection's lock before failing
+};
+
+// A stored URL, read back from its columns
+struct StoredURL {
+  int64_t id{0};
+  SchemeId scheme_id{SchemeId::unknown};
+  std::string scheme;  // Lowercase; the stored text for unknown schemes
+  std::string host;    // Lowercase
+  uint16_t port{0};    // The scheme default if not specified, as URLView reports it
+  std::string path;
+  std::string query;
+  int status{0};
+
+  // Reassembled scheme://host[:port]path[?query], without a default port
+  std::string href() const;
+};
+
+// Filter for URLStore::find. With a host the lookup is a range scan of the
+// (host, path) index; an empty host matches every host and scans the table.
+struct URLStoreQuery {
+  std::string_view host{};
+  std::string_view path_prefix{};  // Byte-wise and case-sensitive, as paths are
+  int status{-1};                // Any status when negative
+  size_t limit{0};               // 0 for no limit
+};
+
+// Parsed URLs in SQLite, one row per distinct URL with the components in
+// their own columns: scheme id, interned host id, port, path, query and a
+// caller-defined status (e.g. pending or fetched for a crawl frontier).
+// Hosts live in their own table and are cached in memory by interned
+// pointer, so a batch resolves each distinct host once.
+//
+// Statements are prepared once per store and reused. A store is one
+// connection and is not thread-safe; open one per thread, and WAL mode lets
+// them read while another writes. SQLite errors throw SQLite::Exception, a
+// std::runtime_error.
+class URLStore {
+public:
+  // path may be ":memory:" for a private in-memory database
+  explicit URLStore(const std::string& path, const URLStoreOptions& options = {});
+  ~URLStore();
+
+  URLStore(URLStore&& other) noexcept;
+  URLStore& operator=(URLStore&& other) noexcept;
+  URLStore(const URLStore&) = delete;
+  URLStore& operator=(const URLStore&) = delete;
+
+  // Inserts the valid rows of the batch, skipping URLs already stored.
+  // Returns the number of new rows.
+  size_t insert(const URLBatch& batch, int status = 0);
+
+  // Single-row insert in its own transaction; prefer the batch overload
+  // for anything but a trickle. False if the URL was already stored.
+  bool insert(const URLView& url, int status = 0);
+
+  // Matching rows, in path order within a host
+  std::vector<StoredURL> find(const URLStoreQuery& query);
+
+  // False if there is no row with that id
+  bool set_status(int64_t id, int status);
+
+  size_t size();
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace seedlib
+
+#endif
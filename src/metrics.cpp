@@ -0,0 +1,465 @@
+// src/metrics.cpp
+#include "seedlib/metrics.hpp"
+#include "seedlib/logging.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace seedlib::metrics {
+
+namespace detail {
+    namespace {
+        // Shared by threads whose own block could not be allocated. Never
+        // checked out, but always in the list so readers include it.
+        ThreadBlock fallback_block;
+        std::atomic<ThreadBlock*> blocks{&fallback_block};
+
+        // Returns the block to the pool when its thread exits
+        struct BlockOwner {
+            ThreadBlock* block{nullptr};
+            ~BlockOwner() {
+                if (!block) return;
+                thread_block = nullptr;
+                block->in_use.store(false, std::memory_order_release);
+            }
+        };
+        thread_local BlockOwner owner;
+    }
+
+    ThreadBlock* attach_thread() noexcept {
+        ThreadBlock* block = nullptr;
+        for (ThreadBlock* it = blocks.load(std::memory_order_acquire); it; it = it->next) {
+            bool expected = false;
+            if (it != &fallback_block && !it->in_use.load(std::memory_order_relaxed) &&
+                it->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                block = it;
+                break;
+            }
+        }
+        if (!block) {
+            block = new (std::nothrow) ThreadBlock;
+            if (!block) return &fallback_block;  // Retried on the next update
+            block->in_use.store(true, std::memory_order_relaxed);
+            block->next = blocks.load(std::memory_order_relaxed);
+            while (!blocks.compare_exchange_weak(block->next, block, std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+            }
+        }
+        owner.block = block;
+        thread_block = block;
+        return block;
+    }
+
+    HistogramCells* attach_histogram(ThreadBlock& block, uint32_t id) noexcept {
+        auto* cells = new (std::nothrow) HistogramCells;
+        if (!cells) return nullptr;
+        // Only the fallback block can race here
+        HistogramCells* expected = nullptr;
+        if (!block.histograms[id].compare_exchange_strong(expected, cells, std::memory_order_release,
+                                                          std::memory_order_acquire)) {
+            delete cells;
+            return expected;
+        }
+        return cells;
+    }
+
+    void append_label(fmt::memory_buffer& out, std::string_view key, std::string_view value) {
+        out.push_back(out.size() == 0 ? '{' : ',');
+        out.append(key.data(), key.data() + key.size());
+        out.append(std::string_view("=\""));
+        for (char c : value) {
+            if (c == '\\' || c == '"') {
+                out.push_back('\\');
+                out.push_back(c);
+            } else if (c == '\n') {
+                out.append(std::string_view("\\n"));
+            } else {
+                out.push_back(c);
+            }
+        }
+        out.push_back('"');
+    }
+
+    void close_labels(fmt::memory_buffer& out) {
+        if (out.size() != 0) out.push_back('}');
+    }
+}
+
+namespace {
+    using detail::ThreadBlock;
+
+    enum class Kind : uint8_t { counter, gauge, histogram };
+
+    struct Entry {
+        uint32_t id;
+        double scale;
+    };
+
+    struct Series {
+        std::string name;
+        std::string labels;  // Rendered, "" or {k="v",...}
+        Kind kind;
+        uint32_t id;
+        double scale;
+    };
+
+    // Id 0 of each kind is the sink behind default-constructed handles
+    constexpr uint32_t kLimits[] = {detail::kMaxCounters, detail::kMaxGauges, detail::kMaxHistograms};
+
+    std::atomic<uint64_t> gauge_cells[detail::kMaxGauges] = {};
+
+    class Registry {
+    public:
+        // Intentionally leaked so handles and the reporter stay usable
+        // during static destruction
+        static Registry& instance() {
+            static Registry* registry = new Registry;
+            return *registry;
+        }
+
+        Entry get(std::string_view name, std::string_view labels, Kind kind, double scale) {
+            std::string& key = scratch_key(name, labels);
+            {
+                std::shared_lock<std::shared_mutex> lock(mutex_);
+                auto it = index_.find(key);
+                if (it != index_.end()) return checked(series_[it->second], kind);
+            }
+
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            auto it = index_.find(key);
+            if (it != index_.end()) return checked(series_[it->second], kind);
+
+            auto kind_it = kinds_.find(name);
+            if (kind_it != kinds_.end() && kind_it->second != kind) {
+                throw std::invalid_argument("metric " + std::string(name) + " already has another type");
+            }
+            uint32_t& next = next_id_[static_cast<int>(kind)];
+            if (next == kLimits[static_cast<int>(kind)]) {
+                throw std::length_error("too many metric series for " + std::string(name));
+            }
+
+            series_.push_back(Series{std::string(name), std::string(labels), kind, next++, scale});
+            index_.emplace(key, series_.size() - 1);
+            if (kind_it == kinds_.end()) kinds_.emplace(std::string(name), kind);
+            return Entry{series_.back().id, scale};
+        }
+
+        // Registration order, grouped by name
+        std::vector<Series> list() const {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            std::vector<Series> result = series_;
+            std::stable_sort(result.begin(), result.end(),
+                             [](const Series& a, const Series& b) { return a.name < b.name; });
+            return result;
+        }
+
+    private:
+        Registry() = default;
+
+        static std::string& scratch_key(std::string_view name, std::string_view labels) {
+            thread_local std::string key;
+            key.assign(name.data(), name.size());
+            key.append(labels.data(), labels.size());
+            return key;
+        }
+
+        static Entry checked(const Series& series, Kind kind) {
+            if (series.kind != kind) {
+                throw std::invalid_argument("metric " + series.name + " already has another type");
+            }
+            return Entry{series.id, series.scale};
+        }
+
+        mutable std::shared_mutex mutex_;
+        std::vector<Series> series_;
+        std::map<std::string, size_t, std::less<>> index_;  // name + labels
+        std::map<std::string, Kind, std::less<>> kinds_;
+        uint32_t next_id_[3] = {1, 1, 1};
+    };
+
+    std::string render_labels(std::initializer_list<Label> labels) {
+        fmt::memory_buffer out;
+        for (const auto& [key, value] : labels) detail::append_label(out, key, value);
+        detail::close_labels(out);
+        return std::string(out.data(), out.size());
+    }
+
+    uint64_t double_bits(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    double bits_double(uint64_t bits) {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // Integer values print exactly; scaled ones go back to their unit
+    void append_value(fmt::memory_buffer& out, uint64_t value, double scale) {
+        if (scale == 1.0) {
+            fmt::format_to(std::back_inserter(out), "{}", value);
+        } else {
+            fmt::format_to(std::back_inserter(out), "{}", static_cast<double>(value) / scale);
+        }
+    }
+
+    void append_text(fmt::memory_buffer& out, std::string_view text) {
+        out.append(text.data(), text.data() + text.size());
+    }
+
+    // Prometheus names only allow [a-zA-Z0-9_:]
+    void append_name(fmt::memory_buffer& out, std::string_view name) {
+        for (char c : name) {
+            const bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                               c == '_' || c == ':';
+            out.push_back(valid ? c : '_');
+        }
+    }
+
+    // labels with one more label appended
+    void append_labels_with(fmt::memory_buffer& out, std::string_view labels, std::string_view extra) {
+        if (labels.empty()) {
+            out.push_back('{');
+        } else {
+            out.append(labels.data(), labels.data() + labels.size() - 1);
+            out.push_back(',');
+        }
+        append_text(out, extra);
+        out.push_back('}');
+    }
+
+    uint64_t counter_total(uint32_t id) {
+        uint64_t total = 0;
+        for (ThreadBlock* b = detail::blocks.load(std::memory_order_acquire); b; b = b->next) {
+            total += b->counters[id].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    HistogramSnapshot snapshot_of(uint32_t id) {
+        HistogramSnapshot result;
+        for (ThreadBlock* b = detail::blocks.load(std::memory_order_acquire); b; b = b->next) {
+            const detail::HistogramCells* cells = b->histograms[id].load(std::memory_order_acquire);
+            if (!cells) continue;
+            if (result.buckets.empty()) result.buckets.assign(detail::kBuckets, 0);
+            result.count += cells->count.load(std::memory_order_relaxed);
+            result.sum += cells->sum.load(std::memory_order_relaxed);
+            result.max = std::max(result.max, cells->max.load(std::memory_order_relaxed));
+            for (size_t i = 0; i < detail::kBuckets; ++i) {
+                result.buckets[i] += cells->buckets[i].load(std::memory_order_relaxed);
+            }
+        }
+        return result;
+    }
+
+    class Reporter {
+    public:
+        static Reporter& instance() {
+            static Reporter reporter;
+            return reporter;
+        }
+
+        ~Reporter() { stop(); }
+
+        void start(std::chrono::milliseconds interval) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            interval_ = std::max(interval, std::chrono::milliseconds(1));
+            if (thread_.joinable()) {
+                wake_.notify_all();
+                return;
+            }
+            stopping_ = false;
+            thread_ = std::thread([this] { run(); });
+        }
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!thread_.joinable()) return;
+                stopping_ = true;
+            }
+            wake_.notify_all();
+            thread_.join();
+        }
+
+    private:
+        void run() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!stopping_) {
+                const auto interval = interval_;
+                if (wake_.wait_for(lock, interval, [&] { return stopping_ || interval_ != interval; })) continue;
+                lock.unlock();
+                Logger& logger = Logger::instance();
+                if (logger.should_log(spdlog::level::info)) logger.info("METRICS {}", summary());
+                lock.lock();
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::chrono::milliseconds interval_{0};
+        bool stopping_{false};
+        std::thread thread_;
+    };
+}
+
+namespace detail {
+    void record_rendered(std::string_view name, std::string_view labels, double value) {
+        const Entry entry = Registry::instance().get(name, labels, Kind::histogram, 1000.0);
+        Histogram(entry.id, entry.scale).observe(value);
+    }
+}
+
+uint64_t Counter::value() const noexcept {
+    return counter_total(id_);
+}
+
+void Gauge::set(double value) const noexcept {
+    gauge_cells[id_].store(double_bits(value), std::memory_order_relaxed);
+}
+
+void Gauge::add(double delta) const noexcept {
+    uint64_t bits = gauge_cells[id_].load(std::memory_order_relaxed);
+    while (!gauge_cells[id_].compare_exchange_weak(bits, double_bits(bits_double(bits) + delta),
+                                                   std::memory_order_relaxed)) {
+    }
+}
+
+double Gauge::value() const noexcept {
+    return bits_double(gauge_cells[id_].load(std::memory_order_relaxed));
+}
+
+uint64_t HistogramSnapshot::percentile(double q) const noexcept {
+    if (count == 0 || buckets.empty()) return 0;
+    const double clamped = std::min(std::max(q, 0.0), 1.0);
+    const auto target = std::max<uint64_t>(1, static_cast<uint64_t>(clamped * static_cast<double>(count) + 0.999999));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= target) return std::min(detail::bucket_upper(i), max);
+    }
+    return max;
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+    return snapshot_of(id_);
+}
+
+Counter counter(std::string_view name, std::initializer_list<Label> labels) {
+    return Counter(Registry::instance().get(name, render_labels(labels), Kind::counter, 1.0).id);
+}
+
+Gauge gauge(std::string_view name, std::initializer_list<Label> labels) {
+    return Gauge(Registry::instance().get(name, render_labels(labels), Kind::gauge, 1.0).id);
+}
+
+Histogram histogram(std::string_view name, std::initializer_list<Label> labels, double scale) {
+    const Entry entry = Registry::instance().get(name, render_labels(labels), Kind::histogram, scale);
+    return Histogram(entry.id, entry.scale);
+}
+
+std::string summary() {
+    fmt::memory_buffer out;
+    for (const Series& series : Registry::instance().list()) {
+        if (out.size() != 0) out.push_back(' ');
+        append_text(out, series.name);
+        if (series.kind != Kind::histogram) {
+            append_text(out, series.labels);
+            out.push_back('=');
+            if (series.kind == Kind::counter) {
+                fmt::format_to(std::back_inserter(out), "{}", counter_total(series.id));
+            } else {
+                fmt::format_to(std::back_inserter(out), "{}", bits_double(gauge_cells[series.id].load(std::memory_order_relaxed)));
+            }
+            continue;
+        }
+
+        const HistogramSnapshot snapshot = snapshot_of(series.id);
+        if (!series.labels.empty()) {
+            append_text(out, std::string_view(series.labels).substr(0, series.labels.size() - 1));
+            out.push_back(',');
+        } else {
+            out.push_back('{');
+        }
+        fmt::format_to(std::back_inserter(out), "count={},mean={}", snapshot.count, snapshot.mean() / series.scale);
+        for (auto [label, q] : {std::pair{",p50=", 0.5}, std::pair{",p90=", 0.9}, std::pair{",p99=", 0.99}}) {
+            append_text(out, label);
+            append_value(out, snapshot.percentile(q), series.scale);
+        }
+        append_text(out, ",max=");
+        append_value(out, snapshot.max, series.scale);
+        out.push_back('}');
+    }
+    return std::string(out.data(), out.size());
+}
+
+std::string prometheus() {
+    fmt::memory_buffer out;
+    std::string_view last_name;
+    const std::vector<Series> all = Registry::instance().list();
+    for (const Series& series : all) {
+        if (series.name != last_name) {
+            append_text(out, "# TYPE ");
+            append_name(out, series.name);
+            append_text(out, series.kind == Kind::counter ? " counter\n"
+                             : series.kind == Kind::gauge ? " gauge\n"
+                                                          : " summary\n");
+            last_name = series.name;
+        }
+
+        if (series.kind != Kind::histogram) {
+            append_name(out, series.name);
+            append_text(out, series.labels);
+            out.push_back(' ');
+            if (series.kind == Kind::counter) {
+                fmt::format_to(std::back_inserter(out), "{}\n", counter_total(series.id));
+            } else {
+                fmt::format_to(std::back_inserter(out), "{}\n", bits_double(gauge_cells[series.id].load(std::memory_order_relaxed)));
+            }
+            continue;
+        }
+
+        const HistogramSnapshot snapshot = snapshot_of(series.id);
+        for (auto [label, q] : {std::pair{"quantile=\"0.5\"", 0.5}, std::pair{"quantile=\"0.9\"", 0.9},
+                                std::pair{"quantile=\"0.99\"", 0.99}}) {
+            append_name(out, series.name);
+            append_labels_with(out, series.labels, label);
+            out.push_back(' ');
+            append_value(out, snapshot.percentile(q), series.scale);
+            out.push_back('\n');
+        }
+        append_name(out, series.name);
+        append_text(out, "_sum");
+        append_text(out, series.labels);
+        out.push_back(' ');
+        append_value(out, snapshot.sum, series.scale);
+        out.push_back('\n');
+        append_name(out, series.name);
+        append_text(out, "_count");
+        append_text(out, series.labels);
+        fmt::format_to(std::back_inserter(out), " {}\n", snapshot.count);
+    }
+    return std::string(out.data(), out.size());
+}
+
+void start_reporting(std::chrono::milliseconds interval) {
+    Reporter::instance().start(interval);
+}
+
+void start_reporting() {
+    start_reporting(std::chrono::milliseconds(LOG_FLUSH_INTERVAL_MS));
+}
+
+void stop_reporting() {
+    Reporter::instance().stop();
+}
+
+} // namespace seedlib::metrics
@@ -0,0 +1,161 @@
+// src/percent_encoding.cpp
+#include "seedlib/percent_encoding.hpp"
+#include "seedlib/detail/simd_scan.hpp"
+#include <array>
+#include <cstring>
+
+namespace seedlib {
+
+namespace {
+    constexpr std::array<int8_t, 256> make_hex_table() {
+        std::array<int8_t, 256> table{};
+        for (auto& value : table) value = -1;
+        for (int c = '0'; c <= '9'; ++c) table[c] = static_cast<int8_t>(c - '0');
+        for (int c = 'a'; c <= 'f'; ++c) table[c] = static_cast<int8_t>(c - 'a' + 10);
+        for (int c = 'A'; c <= 'F'; ++c) table[c] = static_cast<int8_t>(c - 'A' + 10);
+        return table;
+    }
+
+    constexpr auto hex_table = make_hex_table();
+
+    // ALPHA / DIGIT / "-" / "." / "_" / "~"
+    constexpr std::array<bool, 256> make_unreserved_table() {
+        std::array<bool, 256> table{};
+        for (int c = 'a'; c <= 'z'; ++c) table[c] = true;
+        for (int c = 'A'; c <= 'Z'; ++c) table[c] = true;
+        for (int c = '0'; c <= '9'; ++c) table[c] = true;
+        for (unsigned char c : std::string_view("-._~")) table[c] = true;
+        return table;
+    }
+
+    constexpr auto unreserved_table = make_unreserved_table();
+
+    inline int hex_value(char c) {
+        return hex_table[static_cast<unsigned char>(c)];
+    }
+
+    inline const char* next_special(const char* p, const char* end, PercentDecodeMode mode) {
+        return mode == PercentDecodeMode::form ? simd::find_either(p, end, '%', '+')
+                                               : simd::find_byte(p, end, '%');
+    }
+
+    // out may equal in: the write cursor never passes the read cursor.
+    // Lenient decoding copies a malformed escape's '%' through and goes on.
+    PercentDecodeResult decode(const char* in, size_t size, char* out, PercentDecodeMode mode,
+                               bool lenient = false) {
+        const char* p = in;
+        const char* const end = in + size;
+        char* o = out;
+
+        for (;;) {
+            // Copy the run of literal bytes up to the next escape in one go
+            const char* run_end = next_special(p, end, mode);
+            const size_t run = static_cast<size_t>(run_end - p);
+            if (o != p) std::memmove(o, p, run);
+            o += run;
+            p = run_end;
+            if (p == end) break;
+
+            if (*p == '+') {
+                *o++ = ' ';
+                ++p;
+                continue;
+            }
+
+            const int hi = end - p >= 3 ? hex_value(p[1]) : -1;
+            const int lo = end - p >= 3 ? hex_value(p[2]) : -1;
+            if ((hi | lo) < 0) {
+                if (!lenient) return {static_cast<size_t>(o - out), static_cast<size_t>(p - in), false};
+                *o++ = *p++;
+                continue;
+            }
+            *o++ = static_cast<char>((hi << 4) | lo);
+            p += 3;
+        }
+
+        return {static_cast<size_t>(o - out), 0, true};
+    }
+}
+
+bool needs_percent_decode(std::string_view input, PercentDecodeMode mode) noexcept {
+    const char* end = input.data() + input.size();
+    return next_special(input.data(), end, mode) != end;
+}
+
+PercentDecodeResult percent_decode(std::string_view input, char* out,
+                                   PercentDecodeMode mode) noexcept {
+    return decode(input.data(), input.size(), out, mode);
+}
+
+PercentDecodeResult percent_decode_in_place(char* data, size_t size,
+                                            PercentDecodeMode mode) noexcept {
+    return decode(data, size, data, mode);
+}
+
+void percent_encode(std::string_view input, std::string& out, PercentDecodeMode mode) {
+    constexpr char hex_digits[] = "0123456789ABCDEF";
+    const bool form = mode == PercentDecodeMode::form;
+
+    size_t escaped = 0;
+    for (char c : input) {
+        escaped += !unreserved_table[static_cast<unsigned char>(c)] && !(form && c == ' ');
+    }
+    out.reserve(out.size() + input.size() + 2 * escaped);
+
+    for (char c : input) {
+        const auto byte = static_cast<unsigned char>(c);
+        if (unreserved_table[byte]) {
+            out += c;
+        } else if (form && c == ' ') {
+            out += '+';
+        } else {
+            out += '%';
+            out += hex_digits[byte >> 4];
+            out += hex_digits[byte & 0x0F];
+        }
+    }
+}
+
+bool percent_decoded_equals(std::string_view encoded, std::string_view decoded,
+                            PercentDecodeMode mode) noexcept {
+    // Decoding never grows the text, so a shorter input cannot match;
+    // otherwise walk both and bail at the first differing byte
+    if (encoded.size() < decoded.size()) return false;
+
+    const char* p = encoded.data();
+    const char* const end = p + encoded.size();
+    for (char expected : decoded) {
+        if (p == end) return false;
+        char actual = *p++;
+        if (actual == '+' && mode == PercentDecodeMode::form) {
+            actual = ' ';
+        } else if (actual == '%' && end - p >= 2 && (hex_value(p[0]) | hex_value(p[1])) >= 0) {
+            actual = static_cast<char>((hex_value(p[0]) << 4) | hex_value(p[1]));
+            p += 2;
+        }
+        if (actual != expected) return false;
+    }
+    return p == end;
+}
+
+PercentDecodeResult percent_decode_in_place(std::string& text, PercentDecodeMode mode) {
+    // Check every escape first so a failure leaves the string intact
+    const char* const begin = text.data();
+    const char* const end = begin + text.size();
+    for (const char* p = simd::find_byte(begin, end, '%'); p != end;
+         p = simd::find_byte(p + 3, end, '%')) {
+        if (end - p < 3 || (hex_value(p[1]) | hex_value(p[2])) < 0) {
+            return {0, static_cast<size_t>(p - begin), false};
+        }
+    }
+
+    auto result = decode(text.data(), text.size(), text.data(), mode);
+    text.resize(result.size);
+    return result;
+}
+
+void percent_decode_lenient(std::string& text, PercentDecodeMode mode) {
+    text.resize(decode(text.data(), text.size(), text.data(), mode, true).size);
+}
+
+} // namespace seedlib
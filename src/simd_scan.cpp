@@ -0,0 +1,247 @@
+// src/simd_scan.cpp
+#include "seedlib/detail/simd_scan.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SEEDLIB_SIMD_X86 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SEEDLIB_SIMD_NEON 1
+#endif
+
+namespace seedlib::simd {
+
+namespace {
+    const char* find_either_scalar(const char* p, const char* last, char a, char b) noexcept {
+        for (; p != last; ++p) {
+            if (*p == a || *p == b) return p;
+        }
+        return last;
+    }
+
+    constexpr bool is_hex(char c) noexcept {
+        const auto u = static_cast<unsigned char>(c);
+        return (u >= '0' && u <= '9') || ((u | 0x20) >= 'a' && (u | 0x20) <= 'f');
+    }
+
+    // Hex digits of escapes are in allowed, so skipping them is only a
+    // shortcut; the vector versions check every byte with the two after it
+    const char* skip_escaped_scalar(const char* p, const char* last, const ByteClass& allowed) noexcept {
+        for (; p != last; ++p) {
+            if (allowed.contains(*p)) continue;
+            if (*p != '%' || last - p < 3 || !is_hex(p[1]) || !is_hex(p[2])) return p;
+            p += 2;
+        }
+        return last;
+    }
+
+#if defined(SEEDLIB_SIMD_X86)
+    __attribute__((target("sse2")))
+    const char* find_either_sse2(const char* p, const char* last, char a, char b) noexcept {
+        const __m128i va = _mm_set1_epi8(a);
+        const __m128i vb = _mm_set1_epi8(b);
+        for (; last - p >= 16; p += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const int mask = _mm_movemask_epi8(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb)));
+            if (mask) return p + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        return find_either_scalar(p, last, a, b);
+    }
+
+    __attribute__((target("avx2")))
+    const char* find_either_avx2(const char* p, const char* last, char a, char b) noexcept {
+        const __m256i va = _mm256_set1_epi8(a);
+        const __m256i vb = _mm256_set1_epi8(b);
+        for (; last - p >= 32; p += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            const int mask = _mm256_movemask_epi8(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, va), _mm256_cmpeq_epi8(chunk, vb)));
+            if (mask) return p + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        // Finish with VEX-encoded 128-bit compares rather than calling the
+        // SSE2 version: legacy SSE code running with dirty upper YMM state
+        // pays an AVX-SSE transition penalty far larger than the scan
+        if (last - p >= 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const int mask = _mm_movemask_epi8(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm256_castsi256_si128(va)),
+                             _mm_cmpeq_epi8(chunk, _mm256_castsi256_si128(vb))));
+            if (mask) return p + __builtin_ctz(static_cast<unsigned>(mask));
+            p += 16;
+        }
+        _mm256_zeroupper();
+        return find_either_scalar(p, last, a, b);
+    }
+
+    constexpr ByteClass kHexClass = make_byte_class(is_hex);
+
+    // Nonzero lanes where the byte is in the class with these tables
+    __attribute__((target("ssse3"), always_inline))
+    inline __m128i class_lanes16(__m128i chunk, __m128i low, __m128i high) noexcept {
+        const __m128i nibble = _mm_set1_epi8(0x0F);
+        return _mm_and_si128(_mm_shuffle_epi8(low, _mm_and_si128(chunk, nibble)),
+                             _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(chunk, 4), nibble)));
+    }
+
+    struct Tables16 {
+        __m128i low, high, hex_low, hex_high;
+    };
+
+    // Bytes of the 16 at p that fail skip_escaped: outside the class and
+    // not a '%', or a '%' without hex digits in the next two bytes, which
+    // are read with two more unaligned loads. Reads p[0..17].
+    __attribute__((target("ssse3"), always_inline))
+    inline uint32_t escaped_failures16(const char* p, const Tables16& t) noexcept {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i zero = _mm_setzero_si128();
+        const auto outside =
+            static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(class_lanes16(chunk, t.low, t.high), zero)));
+        if (!outside) return 0;
+        const auto percent = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('%'))));
+        if (!percent) return outside;
+
+        const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1));
+        const __m128i after = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 2));
+        const auto unescaped = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(class_lanes16(next, t.hex_low, t.hex_high), zero),
+                         _mm_cmpeq_epi8(class_lanes16(after, t.hex_low, t.hex_high), zero))));
+        return (outside & ~percent) | (percent & unescaped);
+    }
+
+    // Needs at least 18 bytes. The last vector is loaded so that its
+    // lookahead ends flush with last, re-reading bytes that already passed;
+    // they pass again, since each byte's result depends only on it and the
+    // two after it. The final two bytes, which no vector covers, go to the
+    // scalar loop.
+    __attribute__((target("ssse3"), always_inline))
+    inline const char* skip_escaped16(const char* p, const char* last, const ByteClass& allowed) noexcept {
+        const Tables16 t{_mm_loadu_si128(reinterpret_cast<const __m128i*>(allowed.low)),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(allowed.high)),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(kHexClass.low)),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(kHexClass.high))};
+        for (; last - p >= 18; p += 16) {
+            if (const uint32_t failures = escaped_failures16(p, t)) return p + __builtin_ctz(failures);
+        }
+        p = last - 18;
+        if (const uint32_t failures = escaped_failures16(p, t)) return p + __builtin_ctz(failures);
+        return skip_escaped_scalar(last - 2, last, allowed);
+    }
+
+    __attribute__((target("ssse3")))
+    const char* skip_escaped_ssse3(const char* p, const char* last, const ByteClass& allowed) noexcept {
+        return skip_escaped16(p, last, allowed);
+    }
+
+    __attribute__((target("avx2"), always_inline))
+    inline __m256i class_lanes32(__m256i chunk, __m256i low, __m256i high) noexcept {
+        const __m256i nibble = _mm256_set1_epi8(0x0F);
+        return _mm256_and_si256(_mm256_shuffle_epi8(low, _mm256_and_si256(chunk, nibble)),
+                                _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(chunk, 4), nibble)));
+    }
+
+    struct Tables32 {
+        __m256i low, high, hex_low, hex_high;
+    };
+
+    // escaped_failures16 for 32 bytes; reads p[0..33]
+    __attribute__((target("avx2"), always_inline))
+    inline uint32_t escaped_failures32(const char* p, const Tables32& t) noexcept {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i zero = _mm256_setzero_si256();
+        const auto outside = static_cast<uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(class_lanes32(chunk, t.low, t.high), zero)));
+        if (!outside) return 0;
+        const auto percent =
+            static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('%'))));
+        if (!percent) return outside;
+
+        const __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 1));
+        const __m256i after = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 2));
+        const auto unescaped = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(class_lanes32(next, t.hex_low, t.hex_high), zero),
+                            _mm256_cmpeq_epi8(class_lanes32(after, t.hex_low, t.hex_high), zero))));
+        return (outside & ~percent) | (percent & unescaped);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i broadcast_table(const uint8_t (&table)[16]) noexcept {
+        return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+    }
+
+    __attribute__((target("avx2")))
+    const char* skip_escaped_avx2(const char* p, const char* last, const ByteClass& allowed) noexcept {
+        // VEX-encoded 128-bit vectors for what is too short for one 256-bit
+        // step, for the same reason find_either_avx2 avoids the SSE2 version
+        if (last - p < 34) return skip_escaped16(p, last, allowed);
+
+        const Tables32 t{broadcast_table(allowed.low), broadcast_table(allowed.high),
+                         broadcast_table(kHexClass.low), broadcast_table(kHexClass.high)};
+        for (; last - p >= 34; p += 32) {
+            if (const uint32_t failures = escaped_failures32(p, t)) return p + __builtin_ctz(failures);
+        }
+        p = last - 34;
+        if (const uint32_t failures = escaped_failures32(p, t)) return p + __builtin_ctz(failures);
+        // Explicit, as GCC merges this tail call with skip_escaped16's and
+        // drops the vzeroupper it would insert
+        _mm256_zeroupper();
+        return skip_escaped_scalar(last - 2, last, allowed);
+    }
+#elif defined(SEEDLIB_SIMD_NEON)
+    const char* find_either_neon(const char* p, const char* last, char a, char b) noexcept {
+        const uint8x16_t va = vdupq_n_u8(static_cast<uint8_t>(a));
+        const uint8x16_t vb = vdupq_n_u8(static_cast<uint8_t>(b));
+        for (; last - p >= 16; p += 16) {
+            const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+            const uint8x16_t eq = vorrq_u8(vceqq_u8(chunk, va), vceqq_u8(chunk, vb));
+            // Narrow each byte lane to a nibble to get a 64-bit mask
+            const uint64_t bits = vget_lane_u64(
+                vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+            if (bits) return p + (__builtin_ctzll(bits) >> 2);
+        }
+        return find_either_scalar(p, last, a, b);
+    }
+#endif
+
+    using FindEither = const char* (*)(const char*, const char*, char, char) noexcept;
+
+    FindEither select_find_either() noexcept {
+#if defined(SEEDLIB_SIMD_X86)
+        if (__builtin_cpu_supports("avx2")) return find_either_avx2;
+        if (__builtin_cpu_supports("sse2")) return find_either_sse2;
+#elif defined(SEEDLIB_SIMD_NEON)
+        return find_either_neon;
+#endif
+        return find_either_scalar;
+    }
+
+    using SkipEscaped = const char* (*)(const char*, const char*, const ByteClass&) noexcept;
+
+    SkipEscaped select_skip_escaped() noexcept {
+#if defined(SEEDLIB_SIMD_X86)
+        if (__builtin_cpu_supports("avx2")) return skip_escaped_avx2;
+        if (__builtin_cpu_supports("ssse3")) return skip_escaped_ssse3;
+#endif
+        return skip_escaped_scalar;
+    }
+}
+
+const char* find_either(const char* first, const char* last, char a, char b) noexcept {
+    // Short runs never reach a full vector, so skip the dispatch
+    if (last - first < 16) {
+        return find_either_scalar(first, last, a, b);
+    }
+    static const FindEither impl = select_find_either();
+    return impl(first, last, a, b);
+}
+
+const char* skip_escaped(const char* first, const char* last, const ByteClass& allowed) noexcept {
+    // The vector versions look two bytes past each vector
+    if (last - first < 18) {
+        return skip_escaped_scalar(first, last, allowed);
+    }
+    static const SkipEscaped impl = select_skip_escaped();
+    return impl(first, last, allowed);
+}
+
+} // namespace seedlib::simd
@@ -0,0 +1,139 @@
+// src/tracing.cpp
+#include "seedlib/tracing.hpp"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace seedlib::tracing {
+
+namespace {
+    struct Event {
+        const char* name;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    // One thread's events; the lock is only ever contended by an export
+    struct ThreadEvents {
+        std::mutex mutex;
+        std::vector<Event> events;
+        uint32_t tid{0};
+    };
+
+    struct Capture {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<ThreadEvents>> threads;
+        std::atomic<size_t> remaining{0};
+        uint64_t origin{0};
+        bool has_origin{false};
+    };
+
+    Capture& capture_state() {
+        static Capture* state = new Capture;  // Leaked; threads may still record at exit
+        return *state;
+    }
+
+    ThreadEvents* thread_events() {
+        thread_local std::shared_ptr<ThreadEvents> mine;
+        if (!mine) {
+            auto events = std::make_shared<ThreadEvents>();
+            Capture& state = capture_state();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            events->tid = static_cast<uint32_t>(state.threads.size() + 1);
+            state.threads.push_back(events);
+            mine = std::move(events);
+        }
+        return mine.get();
+    }
+
+    double calibrate() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        using clock = std::chrono::steady_clock;
+        const auto begin = clock::now();
+        const uint64_t first = ticks();
+        auto now = begin;
+        while (now - begin < std::chrono::milliseconds(2)) now = clock::now();
+        const uint64_t last = ticks();
+        const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - begin).count());
+        return last > first ? ns / static_cast<double>(last - first) : 1.0;
+#else
+        using period = std::chrono::steady_clock::period;
+        return 1e9 * static_cast<double>(period::num) / static_cast<double>(period::den);
+#endif
+    }
+}
+
+double ns_per_tick() noexcept {
+    static const double value = calibrate();
+    return value;
+}
+
+namespace detail {
+    void capture(const char* name, uint64_t start, uint64_t end) noexcept {
+        Capture& state = capture_state();
+        size_t remaining = state.remaining.load(std::memory_order_relaxed);
+        do {
+            if (remaining == 0) return;
+        } while (!state.remaining.compare_exchange_weak(remaining, remaining - 1, std::memory_order_relaxed));
+
+        try {
+            ThreadEvents* mine = thread_events();
+            std::lock_guard<std::mutex> lock(mine->mutex);
+            mine->events.push_back(Event{name, start, end});
+        } catch (...) {
+            // Tracing never fails the traced call
+        }
+    }
+}
+
+void start_capture(size_t max_events) {
+    Capture& state = capture_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (const auto& thread : state.threads) {
+        std::lock_guard<std::mutex> thread_lock(thread->mutex);
+        thread->events.clear();
+    }
+    state.origin = ticks();
+    state.has_origin = true;
+    state.remaining.store(max_events, std::memory_order_relaxed);
+    detail::capturing.store(true, std::memory_order_relaxed);
+}
+
+void stop_capture() {
+    detail::capturing.store(false, std::memory_order_relaxed);
+    capture_state().remaining.store(0, std::memory_order_relaxed);
+}
+
+size_t write_chrome_trace(std::ostream& out) {
+    Capture& state = capture_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    const double us_per_tick = ns_per_tick() / 1000.0;
+    const uint64_t origin = state.has_origin ? state.origin : 0;
+
+    fmt::memory_buffer json;
+    size_t written = 0;
+    auto append = [&json](std::string_view text) { json.append(text.data(), text.data() + text.size()); };
+    append("{\"traceEvents\":[");
+    for (const auto& thread : state.threads) {
+        std::lock_guard<std::mutex> thread_lock(thread->mutex);
+        for (const Event& event : thread->events) {
+            if (written++ != 0) json.push_back(',');
+            append("{\"name\":\"");
+            for (const char* c = event.name; *c; ++c) {
+                if (*c == '"' || *c == '\\') json.push_back('\\');
+                json.push_back(*c);
+            }
+            fmt::format_to(std::back_inserter(json),
+                           "\",\"cat\":\"seedlib\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}}}",
+                           static_cast<double>(event.start - std::min(origin, event.start)) * us_per_tick,
+                           static_cast<double>(event.end - event.start) * us_per_tick, thread->tid);
+        }
+    }
+    append("],\"displayTimeUnit\":\"ns\"}\n");
+    out.write(json.data(), static_cast<std::streamsize>(json.size()));
+    return written;
+}
+
+} // namespace seedlib::tracing
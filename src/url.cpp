@@ -1 +1,417 @@
-// TODO: URL library implementation
+// src/url.cpp
+#include "seedlib/url.hpp"
+#include "seedlib/metrics.hpp"
+#include "seedlib/percent_encoding.hpp"
+#include "seedlib/tracing.hpp"
+#include "seedlib/detail/url_impl.hpp"
+#if !SEEDLIB_HEADER_ONLY
+#include "seedlib/detail/url_inline.hpp"
+#endif
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <new>
+
+namespace seedlib {
+
+namespace {
+    using namespace detail::url_chars;
+    using detail::ascii_lower;
+}
+
+// Registration builds strings under the registry lock and throws on a name
+// clash or a full registry; series that fail stay detached
+detail::url_chars::ParserMetrics::ParserMetrics() noexcept {
+    static constexpr const char* kNames[kCodes] = {
+        "ok", "invalid_format", "invalid_scheme", "invalid_authority", "invalid_host",
+        "invalid_port", "port_out_of_range", "too_long", "invalid_userinfo", "invalid_path",
+        "invalid_query", "invalid_fragment", "invalid_percent_encoding",
+    };
+    try {
+        parses = metrics::counter("url_parse_total");
+        bytes = metrics::counter("url_parse_bytes_total");
+        for (size_t i = 1; i < kCodes; ++i) {
+            errors[i] = metrics::counter("url_parse_errors_total", {{"code", kNames[i]}});
+        }
+    } catch (...) {
+    }
+}
+
+const detail::url_chars::ParserMetrics detail::url_chars::parser_metrics;
+
+// Storage is rounded up to the allocator's 16-byte granularity; the slack
+// lets small setter edits patch the text in place
+URLImpl* URLImpl::allocate(size_t text_size, std::pmr::memory_resource* resource) {
+    const size_t bytes = (sizeof(URLImpl) + text_size + 15) & ~size_t{15};
+    void* storage = resource ? resource->allocate(bytes, alignof(URLImpl)) : ::operator new(bytes);
+    auto* impl = new (storage) URLImpl();
+    impl->capacity = static_cast<uint32_t>(bytes - sizeof(URLImpl));
+    impl->resource = resource;
+    return impl;
+}
+
+URLImpl* URLImpl::create(const URLView& view, HostInterner* interner,
+                         std::pmr::memory_resource* resource) {
+    // Registered schemes are represented by scheme_id alone
+    const std::string_view scheme =
+        view.scheme_id() == SchemeId::unknown ? view.scheme() : std::string_view();
+    const std::string_view interned =
+        interner && !view.host().empty() ? interner->intern(view.host()) : std::string_view();
+    const std::string_view parts[kComponentCount] = {
+        scheme, interned.data() ? std::string_view() : view.host(), view.path(), view.query(),
+        view.fragment()};
+
+    size_t text_size = 0;
+    for (auto part : parts) text_size += part.size();
+
+    URLImpl* impl = allocate(text_size, resource);
+    char* out = impl->text();
+    for (int c = 0; c < kComponentCount; ++c) {
+        impl->spans[c] = Span{impl->size, static_cast<uint32_t>(parts[c].size())};
+        if (!parts[c].empty()) std::memcpy(out + impl->size, parts[c].data(), parts[c].size());
+        impl->size += static_cast<uint32_t>(parts[c].size());
+    }
+    std::transform(out, out + impl->spans[kScheme].length, out, ascii_lower);
+
+    impl->port = view.port();
+    impl->scheme_id = view.scheme_id();
+    impl->host_address = view.host_address_;
+    impl->interned_host = interned;
+    return impl;
+}
+
+// Like a std::pmr container, a copy does not inherit the source's
+// resource, so copying out of a request arena yields a heap URL
+URLImpl* URLImpl::clone(const URLImpl& other) {
+    URLImpl* impl = allocate(other.size, nullptr);
+    const uint32_t capacity = impl->capacity;
+    std::memcpy(static_cast<void*>(impl), &other, sizeof(URLImpl) + other.size);
+    impl->capacity = capacity;
+    impl->resource = nullptr;
+    return impl;
+}
+
+void URLImpl::destroy(URLImpl* impl) noexcept {
+    if (impl->resource) {
+        impl->resource->deallocate(impl, sizeof(URLImpl) + impl->capacity, alignof(URLImpl));
+    } else {
+        ::operator delete(impl);
+    }
+}
+
+URLImpl* URLImpl::replace(URLImpl* impl, Component component, std::string_view value) {
+    return splice(impl, component, 0, impl->spans[component].length, value);
+}
+
+URLImpl* URLImpl::splice(URLImpl* impl, Component component, uint32_t pos, uint32_t erase,
+                         std::string_view value) {
+    // A value that aliases our own text would be clobbered by the shift
+    const char* text_begin = impl->text();
+    if (value.data() >= text_begin && value.data() < text_begin + impl->size) {
+        const std::string copy(value);
+        return splice(impl, component, pos, erase, copy);
+    }
+
+    const uint32_t at = impl->spans[component].offset + pos;
+    const size_t new_size = impl->size - erase + value.size();
+    if (new_size > UINT32_MAX) {
+        throw URLValidationError("URL too long");
+    }
+
+    URLImpl* target = impl;
+    if (new_size > impl->capacity) {
+        // Grow geometrically so repeated appends stay amortized
+        target = allocate(std::max<size_t>(new_size, size_t{impl->capacity} * 2), impl->resource);
+        const uint32_t capacity = target->capacity;
+        std::memcpy(static_cast<void*>(target), impl, sizeof(URLImpl) + at);
+        target->capacity = capacity;
+    }
+
+    // Shift everything after the edit, then drop the new bytes in
+    const char* tail = impl->text() + at + erase;
+    const size_t tail_size = impl->size - (at + erase);
+    std::memmove(target->text() + at + value.size(), tail, tail_size);
+    if (!value.empty()) std::memcpy(target->text() + at, value.data(), value.size());
+
+    const auto delta = static_cast<uint32_t>(value.size()) - erase;  // modular
+    target->spans[component].length += delta;
+    for (int c = component + 1; c < kComponentCount; ++c) {
+        target->spans[c].offset += delta;
+    }
+    target->size = static_cast<uint32_t>(new_size);
+    return target;
+}
+
+// Query parameters
+std::string QueryParam::decoded_key() const {
+    SEEDLIB_TRACE_SPAN("query.decode");
+    std::string result(key);
+    percent_decode_lenient(result);
+    return result;
+}
+
+std::string QueryParam::decoded_value() const {
+    SEEDLIB_TRACE_SPAN("query.decode");
+    std::string result(value);
+    percent_decode_lenient(result);
+    return result;
+}
+
+std::optional<QueryParam> QueryParams::find(std::string_view key) const noexcept {
+    for (const auto& param : *this) {
+        if (percent_decoded_equals(param.key, key)) return param;
+    }
+    return std::nullopt;
+}
+
+// Error reporting
+const char* URLError::message() const noexcept {
+    switch (code) {
+    case URLErrc::ok:                return "";
+    case URLErrc::invalid_format:    return "Invalid URL format";
+    case URLErrc::invalid_scheme:    return "Invalid scheme";
+    case URLErrc::invalid_authority: return "Invalid authority component";
+    case URLErrc::invalid_host:      return "Invalid host";
+    case URLErrc::invalid_port:      return "Invalid port number";
+    case URLErrc::port_out_of_range: return "Port number out of range";
+    case URLErrc::too_long:          return "URL too long";
+    case URLErrc::invalid_userinfo:  return "Invalid userinfo";
+    case URLErrc::invalid_path:      return "Invalid character in path";
+    case URLErrc::invalid_query:     return "Invalid character in query";
+    case URLErrc::invalid_fragment:  return "Invalid character in fragment";
+    case URLErrc::invalid_percent_encoding: return "Invalid percent-encoding";
+    }
+    return "Unknown error";
+}
+
+// URL class implementation
+std::optional<URL> URL::try_parse(std::string_view url, URLError& error) {
+    SEEDLIB_TRACE_SPAN("url.parse");
+    URLView view;
+    if (!URLImpl::scan(url, view, error)) {
+        return std::nullopt;
+    }
+    return view.to_owned();
+}
+
+std::optional<URL> URL::try_parse(std::string_view url, URLError& error, HostInterner& interner) {
+    SEEDLIB_TRACE_SPAN("url.parse");
+    URLView view;
+    if (!URLImpl::scan(url, view, error)) {
+        return std::nullopt;
+    }
+    return view.to_owned(interner);
+}
+
+std::optional<URL> URL::parse(std::string_view url) {
+    URLError error;
+    return try_parse(url, error);
+}
+
+std::optional<URL> URL::parse(std::string_view url, HostInterner& interner) {
+    URLError error;
+    return try_parse(url, error, interner);
+}
+
+std::optional<URL> URL::try_parse(std::string_view url, URLError& error,
+                                  std::pmr::memory_resource* resource) {
+    SEEDLIB_TRACE_SPAN("url.parse");
+    URLView view;
+    if (!URLImpl::scan(url, view, error)) {
+        return std::nullopt;
+    }
+    return view.to_owned(resource);
+}
+
+std::optional<URL> URL::parse(std::string_view url, std::pmr::memory_resource* resource) {
+    URLError error;
+    return try_parse(url, error, resource);
+}
+
+std::optional<URL> URL::parse(std::string_view url, Arena& arena) {
+    return parse(url, arena.resource());
+}
+
+URL::ValidationResult URL::validate(std::string_view url, ValidationProfile profile) {
+    // Timed here rather than in check, which promises not to allocate; the
+    // span's first use registers its histogram
+    SEEDLIB_TRACE_SPAN("url.validate");
+    if (const URLError error = check(url, profile)) {
+        return {false, error.message()};
+    }
+    return {true, {}};
+}
+
+// URLView implementation
+URL URLView::to_owned() const {
+    return URL(URLImpl::create(*this));
+}
+
+URL URLView::to_owned(HostInterner& interner) const {
+    return URL(URLImpl::create(*this, &interner));
+}
+
+URL URLView::to_owned(std::pmr::memory_resource* resource) const {
+    return URL(URLImpl::create(*this, nullptr, resource));
+}
+
+// Constructor and destructor implementations
+void URL::ImplDeleter::operator()(URLImpl* impl) const noexcept { URLImpl::destroy(impl); }
+
+URL::URL(URLImpl* impl) : impl_(impl) {}
+URL::~URL() = default;
+URL::URL(URL&&) noexcept = default;
+URL& URL::operator=(URL&&) noexcept = default;
+URL::URL(const URL& other) : impl_(URLImpl::clone(*other.impl_)) {}
+URL& URL::operator=(const URL& other) {
+    if (this != &other) {
+        impl_.reset(URLImpl::clone(*other.impl_));
+    }
+    return *this;
+}
+
+
+// Modifier implementations
+void URL::set_scheme(std::string_view scheme) {
+    if (scheme.empty() || !has_class(scheme[0], kAlpha) ||
+        !std::all_of(scheme.begin(), scheme.end(),
+                     [](char c) { return has_class(c, kAlpha | kDigit | kSchemeExtra); })) {
+        throw URLValidationError("Invalid scheme format");
+    }
+
+    const SchemeId id = lookup_scheme(scheme);
+    if (scheme_info(id).special != scheme_info(impl_->scheme_id).special) {
+        throw URLValidationError("Cannot switch between special and non-special schemes");
+    }
+
+    std::string text;
+    if (id == SchemeId::unknown) {
+        text.assign(scheme);
+        std::transform(text.begin(), text.end(), text.begin(), ascii_lower);
+    }
+
+    patch(URLImpl::kScheme, text);
+    impl_->scheme_id = id;
+}
+
+void URL::set_port(uint16_t port) {
+    if (port == 0) {
+        throw URLValidationError("Port cannot be 0");
+    }
+    impl_->port = port;
+}
+
+void URL::set_host(std::string_view host) {
+    IPAddress address;
+    if (host.empty() ? impl_->scheme_id != SchemeId::file
+                     : check_host(host.data(), host.data() + host.size(), address) != nullptr) {
+        throw URLValidationError("Invalid host");
+    }
+    patch(URLImpl::kHost, host);
+    impl_->host_address = address;
+    impl_->interned_host = {};
+}
+
+void URL::set_path(std::string_view path) {
+    if (path.empty()) {
+        path = "/";
+    }
+    if (path[0] != '/' || path.find_first_of("?#") != std::string_view::npos) {
+        throw URLValidationError("Invalid path");
+    }
+    patch(URLImpl::kPath, path);
+}
+
+void URL::set_query(std::string_view query) {
+    if (query.find('#') != std::string_view::npos) {
+        throw URLValidationError("Invalid query");
+    }
+    patch(URLImpl::kQuery, query);
+}
+
+void URL::set_fragment(std::string_view fragment) {
+    patch(URLImpl::kFragment, fragment);
+}
+
+void URL::append_query_param(std::string_view key, std::string_view value) {
+    std::string pair;
+    if (impl_->spans[URLImpl::kQuery].length != 0) pair += '&';
+    percent_encode(key, pair);
+    pair += '=';
+    percent_encode(value, pair);
+
+    const uint32_t end = impl_->spans[URLImpl::kQuery].length;
+    URLImpl* patched = URLImpl::splice(impl_.get(), URLImpl::kQuery, end, 0, pair);
+    if (patched != impl_.get()) impl_.reset(patched);
+}
+
+void URL::patch(uint8_t component, std::string_view value) {
+    URLImpl* patched = URLImpl::replace(impl_.get(), static_cast<URLImpl::Component>(component), value);
+    if (patched != impl_.get()) impl_.reset(patched);
+}
+
+std::string_view URL::port_text(char (&buffer)[5]) const {
+    uint16_t port = impl_->port;
+    if (port == 0 || port == scheme_info(impl_->scheme_id).default_port) {
+        return {};
+    }
+
+    char* p = buffer + sizeof(buffer);
+    do {
+        *--p = static_cast<char>('0' + port % 10);
+        port /= 10;
+    } while (port != 0);
+    return {p, static_cast<size_t>(buffer + sizeof(buffer) - p)};
+}
+
+void URL::append_to(std::string& out) const {
+    SEEDLIB_TRACE_SPAN("url.to_string");
+    char port_buffer[5];
+    const std::string_view port = port_text(port_buffer);
+    const std::string_view scheme = this->scheme();
+    const std::string_view host = this->host();
+    const std::string_view query = this->query();
+    const std::string_view fragment = this->fragment();
+
+    // Exact output length, so the buffer grows at most once
+    const size_t length = scheme.size() + impl_->size - impl_->spans[URLImpl::kScheme].length +
+                          impl_->interned_host.size() + 3 + (port.empty() ? 0 : port.size() + 1) +
+                          (query.empty() ? 0 : 1) + (fragment.empty() ? 0 : 1);
+    if (out.capacity() - out.size() < length) {
+        out.reserve(std::max(out.size() + length, out.capacity() * 2));
+    }
+
+    out += scheme;
+    out += "://";
+    out += host;
+
+    if (!port.empty()) {
+        out += ':';
+        out += port;
+    }
+
+    out += path();
+
+    if (!query.empty()) {
+        out += '?';
+        out += query;
+    }
+
+    if (!fragment.empty()) {
+        out += '#';
+        out += fragment;
+    }
+}
+
+std::string URL::to_string() const {
+    std::string result;
+    append_to(result);
+    return result;
+}
+
+bool URL::is_secure() const {
+    return scheme_info(impl_->scheme_id).secure;
+}
+
+} // namespace seedlib
@@ -0,0 +1,98 @@
+// src/url_batch.cpp
+#include "seedlib/url_batch.hpp"
+#include "seedlib/detail/url_impl.hpp"
+#include "work_stealing.hpp"
+#include <algorithm>
+#include <bitset>
+
+namespace seedlib {
+
+size_t URLBatch::valid_count() const noexcept {
+    size_t count = 0;
+    for (uint64_t word : valid_bits_) {
+        count += std::bitset<64>(word).count();
+    }
+    return count;
+}
+
+URLView URLBatch::view(size_t i) const noexcept {
+    auto to_view_span = [](Span span) { return URLView::Span{span.offset, span.length}; };
+
+    URLView view;
+    view.data_ = bases_[i];
+    view.scheme_ = to_view_span(schemes_[i]);
+    view.host_ = to_view_span(hosts_[i]);
+    view.host_address_ = host_addresses_[i];
+    view.path_ = to_view_span(paths_[i]);
+    view.query_ = to_view_span(queries_[i]);
+    view.fragment_ = to_view_span(fragments_[i]);
+    view.port_ = ports_[i];
+    view.scheme_id_ = scheme_ids_[i];
+    return view;
+}
+
+std::string_view URLBatch::path(size_t i) const noexcept {
+    return paths_[i].length ? slice(i, paths_[i]) : "/";
+}
+
+// resize() on a vector that already has the capacity never allocates, so a
+// reused batch only grows when it sees a larger input than before
+void URLBatch::resize(size_t count) {
+    size_ = count;
+    bases_.resize(count);
+    scheme_ids_.resize(count);
+    ports_.resize(count);
+    schemes_.resize(count);
+    hosts_.resize(count);
+    host_addresses_.resize(count);
+    paths_.resize(count);
+    queries_.resize(count);
+    fragments_.resize(count);
+    errors_.resize(count);
+    valid_bits_.resize((count + 63) / 64);
+    std::fill(valid_bits_.begin(), valid_bits_.end(), 0);
+}
+
+void URLBatch::store(size_t i, const URLView& view) {
+    auto to_batch_span = [](URLView::Span span) { return Span{span.offset, span.length}; };
+
+    bases_[i] = view.data_;
+    scheme_ids_[i] = view.scheme_id_;
+    ports_[i] = view.port_;
+    schemes_[i] = to_batch_span(view.scheme_);
+    hosts_[i] = to_batch_span(view.host_);
+    host_addresses_[i] = view.host_address_;
+    paths_[i] = to_batch_span(view.path_);
+    queries_[i] = to_batch_span(view.query_);
+    fragments_[i] = to_batch_span(view.fragment_);
+}
+
+void parse_batch(const std::string_view* urls, size_t count, URLBatch& out) {
+    parse_batch(urls, count, out, 1);
+}
+
+void parse_batch(const std::string_view* urls, size_t count, URLBatch& out, unsigned threads) {
+    out.resize(count);
+
+    // Chunks are a multiple of 64 rows so no two workers share a validity word
+    constexpr size_t chunk_rows = 1024;
+    const size_t chunk_count = (count + chunk_rows - 1) / chunk_rows;
+
+    WorkStealingRanges::run(chunk_count, threads, [&](size_t chunk) {
+        const size_t end = std::min(count, (chunk + 1) * chunk_rows);
+        URLView view;
+        URLError error;
+        for (size_t i = chunk * chunk_rows; i < end; ++i) {
+            // A failed scan leaves view default-constructed, so the row's
+            // component columns are zeroed as well
+            URLImpl::scan(urls[i], view, error);
+            out.store(i, view);
+            out.errors_[i] = error.code;
+            if (!error) {
+                out.valid_bits_[i / 64] |= uint64_t{1} << (i % 64);
+            }
+        }
+    });
+}
+
+} // namespace seedlib
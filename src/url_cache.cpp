@@ -0,0 +1,195 @@
+// src/url_cache.cpp
+#include "seedlib/url_cache.hpp"
+#include "seedlib/logging.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace seedlib {
+
+struct alignas(64) URLCache::Shard {
+    struct Slot {
+        std::string key;
+        size_t hash{0};
+        std::shared_ptr<const URL> value;
+        std::atomic<bool> referenced{false};
+    };
+
+    static constexpr uint32_t kEmpty = UINT32_MAX;
+
+    mutable std::shared_mutex mutex;
+    std::unique_ptr<Slot[]> slots;
+    size_t slot_count{0};
+    std::atomic<size_t> used{0};  // Written under the exclusive lock
+    size_t hand{0};
+
+    // Open-addressed index of slot numbers, at most half full, so a lookup
+    // hashes the key once and usually touches one bucket
+    std::unique_ptr<uint32_t[]> buckets;
+    size_t bucket_mask{0};
+
+    mutable std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> evictions{0};
+    std::atomic<uint64_t> rejected{0};
+
+    void reset(size_t count) {
+        slots.reset(new Slot[count]);
+        slot_count = count;
+        used.store(0, std::memory_order_relaxed);
+        hand = 0;
+
+        size_t bucket_count = 2;
+        while (bucket_count < count * 2) bucket_count <<= 1;
+        buckets.reset(new uint32_t[bucket_count]);
+        std::fill(buckets.get(), buckets.get() + bucket_count, kEmpty);
+        bucket_mask = bucket_count - 1;
+    }
+
+    // Bucket holding key, or the empty bucket where it would go
+    size_t bucket_of(size_t hash, std::string_view key) const {
+        for (size_t b = hash & bucket_mask;; b = (b + 1) & bucket_mask) {
+            const uint32_t slot = buckets[b];
+            if (slot == kEmpty || (slots[slot].hash == hash && slots[slot].key == key)) return b;
+        }
+    }
+
+    // Backward-shift deletion keeps probe chains intact without tombstones
+    void erase_bucket(size_t b) {
+        for (size_t next = (b + 1) & bucket_mask;; next = (next + 1) & bucket_mask) {
+            const uint32_t slot = buckets[next];
+            if (slot == kEmpty) break;
+            const size_t home = slots[slot].hash & bucket_mask;
+            if (((next - home) & bucket_mask) >= ((next - b) & bucket_mask)) {
+                buckets[b] = slot;
+                b = next;
+            }
+        }
+        buckets[b] = kEmpty;
+    }
+
+    std::shared_ptr<const URL> lookup(size_t hash, std::string_view key) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        const uint32_t slot_index = buckets[bucket_of(hash, key)];
+        if (slot_index == kEmpty) return nullptr;
+        Slot& slot = slots[slot_index];
+        // Relaxed is enough: the bit is only a hint to the CLOCK hand
+        if (!slot.referenced.load(std::memory_order_relaxed)) {
+            slot.referenced.store(true, std::memory_order_relaxed);
+        }
+        return slot.value;
+    }
+
+    std::shared_ptr<const URL> insert(size_t hash, std::string_view key, std::shared_ptr<const URL> value) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        // Another thread may have inserted it while we were parsing
+        if (const uint32_t existing = buckets[bucket_of(hash, key)]; existing != kEmpty) {
+            return slots[existing].value;
+        }
+
+        size_t victim;
+        if (const size_t n = used.load(std::memory_order_relaxed); n < slot_count) {
+            victim = n;
+            used.store(n + 1, std::memory_order_relaxed);
+        } else {
+            // Second chance: clear reference bits until an unreferenced slot
+            while (slots[hand].referenced.exchange(false, std::memory_order_relaxed)) {
+                hand = (hand + 1) % slot_count;
+            }
+            victim = hand;
+            hand = (hand + 1) % slot_count;
+            erase_bucket(bucket_of(slots[victim].hash, slots[victim].key));
+            evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Slot& slot = slots[victim];
+        slot.key.assign(key.data(), key.size());
+        slot.hash = hash;
+        slot.value = std::move(value);
+        slot.referenced.store(false, std::memory_order_relaxed);
+        buckets[bucket_of(hash, key)] = static_cast<uint32_t>(victim);
+        return slot.value;
+    }
+};
+
+URLCache::URLCache(size_t capacity, size_t shard_count) : capacity_(capacity) {
+    size_t shards = 1;
+    while (shards < shard_count && shards < capacity) shards <<= 1;
+    shards_.reset(new Shard[shards]);
+    shard_mask_ = shards - 1;
+
+    const size_t per_shard = std::max<size_t>(1, (capacity + shards - 1) / shards);
+    for (size_t i = 0; i < shards; ++i) shards_[i].reset(per_shard);
+}
+
+URLCache::~URLCache() = default;
+
+URLCache::Shard& URLCache::shard_for(size_t hash) const noexcept {
+    // High bits pick the shard, low bits the bucket within it
+    return shards_[(hash >> (sizeof(size_t) * 8 - 16)) & shard_mask_];
+}
+
+std::shared_ptr<const URL> URLCache::parse(std::string_view url) {
+    const size_t hash = std::hash<std::string_view>{}(url);
+    Shard& shard = shard_for(hash);
+    if (auto cached = shard.lookup(hash, url)) {
+        shard.hits.fetch_add(1, std::memory_order_relaxed);
+        return cached;
+    }
+
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+    auto parsed = URL::parse(url);
+    if (!parsed) {
+        shard.rejected.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return shard.insert(hash, url, std::make_shared<const URL>(std::move(*parsed)));
+}
+
+std::shared_ptr<const URL> URLCache::find(std::string_view url) const {
+    const size_t hash = std::hash<std::string_view>{}(url);
+    Shard& shard = shard_for(hash);
+    auto cached = shard.lookup(hash, url);
+    if (cached) shard.hits.fetch_add(1, std::memory_order_relaxed);
+    return cached;
+}
+
+void URLCache::clear() {
+    for (size_t i = 0; i <= shard_mask_; ++i) {
+        Shard& shard = shards_[i];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.reset(shard.slot_count);
+    }
+}
+
+URLCacheStats URLCache::stats() const noexcept {
+    URLCacheStats stats;
+    for (size_t i = 0; i <= shard_mask_; ++i) {
+        const Shard& shard = shards_[i];
+        stats.hits += shard.hits.load(std::memory_order_relaxed);
+        stats.misses += shard.misses.load(std::memory_order_relaxed);
+        stats.evictions += shard.evictions.load(std::memory_order_relaxed);
+        stats.rejected += shard.rejected.load(std::memory_order_relaxed);
+        stats.size += shard.used.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void URLCache::report_metrics(const std::string& prefix) const {
+    const URLCacheStats current = stats();
+    const uint64_t lookups = current.hits + current.misses;
+    LOG_METRIC(prefix + ".hits", static_cast<double>(current.hits));
+    LOG_METRIC(prefix + ".misses", static_cast<double>(current.misses));
+    LOG_METRIC(prefix + ".evictions", static_cast<double>(current.evictions));
+    LOG_METRIC(prefix + ".rejected", static_cast<double>(current.rejected));
+    LOG_METRIC(prefix + ".size", static_cast<double>(current.size));
+    LOG_METRIC(prefix + ".hit_ratio",
+               lookups ? static_cast<double>(current.hits) / static_cast<double>(lookups) : 0.0);
+}
+
+} // namespace seedlib
@@ -0,0 +1,396 @@
+// src/url_matcher.cpp
+#include "seedlib/url_matcher.hpp"
+#include "seedlib/tracing.hpp"
+#include "seedlib/url.hpp"
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <thread>
+
+namespace seedlib {
+
+namespace {
+    constexpr uint32_t kNone = UINT32_MAX;
+
+    void split(std::string_view text, char separator, std::vector<std::string>& out) {
+        for (size_t begin = 0;;) {
+            const size_t end = text.find(separator, begin);
+            out.emplace_back(text.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin));
+            if (end == std::string_view::npos) return;
+            begin = end + 1;
+        }
+    }
+
+    // Three-way comparison of a lowercase rule label with host text as written
+    int compare_folded(std::string_view lower, std::string_view text) noexcept {
+        const size_t common = std::min(lower.size(), text.size());
+        for (size_t i = 0; i < common; ++i) {
+            const auto a = static_cast<unsigned char>(lower[i]);
+            const auto b = static_cast<unsigned char>(detail::ascii_lower(text[i]));
+            if (a != b) return a < b ? -1 : 1;
+        }
+        return lower.size() == text.size() ? 0 : (lower.size() < text.size() ? -1 : 1);
+    }
+
+    size_t thread_stripe() noexcept {
+        static std::atomic<size_t> next{0};
+        thread_local const size_t stripe = next.fetch_add(1, std::memory_order_relaxed);
+        return stripe;
+    }
+
+    [[noreturn]] void invalid_pattern(std::string_view pattern, const char* reason) {
+        throw std::invalid_argument("invalid URL pattern \"" + std::string(pattern) + "\": " + reason);
+    }
+}
+
+void URLRuleSet::add(std::string_view pattern, uint32_t id) {
+    Rule rule{id, SchemeId::unknown, false, false, {}, {}};
+    std::string_view rest = pattern;
+
+    if (const size_t colon = rest.find("://"); colon != std::string_view::npos) {
+        rule.scheme = lookup_scheme(rest.substr(0, colon));
+        if (rule.scheme == SchemeId::unknown) invalid_pattern(pattern, "unknown scheme");
+        rest.remove_prefix(colon + 3);
+    }
+
+    const size_t slash = rest.find('/');
+    std::string_view host = rest.substr(0, slash);
+    if (host.empty()) invalid_pattern(pattern, "missing host");
+    if (host.find(':') != std::string_view::npos && host.front() != '[') invalid_pattern(pattern, "ports are not matched");
+    if (host == "*") {
+        rule.any_subdomain = true;
+    } else {
+        if (host.size() > 2 && host[0] == '*' && host[1] == '.') {
+            rule.any_subdomain = true;
+            host.remove_prefix(2);
+        }
+        split(host, '.', rule.host_labels);
+        for (std::string& label : rule.host_labels) {
+            if (label.empty()) invalid_pattern(pattern, "empty host label");
+            if (label.find('*') != std::string::npos) invalid_pattern(pattern, "* is only allowed as the first label");
+            std::transform(label.begin(), label.end(), label.begin(), detail::ascii_lower);
+        }
+        std::reverse(rule.host_labels.begin(), rule.host_labels.end());
+    }
+
+    if (slash == std::string_view::npos) {
+        rule.any_path_below = true;
+    } else {
+        split(rest.substr(slash + 1), '/', rule.path_segments);
+        if (rule.path_segments.back() == "*") {
+            rule.path_segments.pop_back();
+            rule.any_path_below = true;
+        }
+        for (const std::string& segment : rule.path_segments) {
+            if (segment.find('*') != std::string::npos) invalid_pattern(pattern, "* is only allowed as the last segment");
+        }
+    }
+    rules_.push_back(std::move(rule));
+}
+
+// Both tries live in flat arrays: a node's edges are one contiguous range,
+// sorted by label for binary search, and labels are slices of one string
+struct URLMatcher::Compiled {
+    struct RuleRef {
+        uint32_t id;
+        SchemeId scheme;
+    };
+
+    struct Range {
+        uint32_t begin{0};
+        uint32_t end{0};
+    };
+
+    struct Label {
+        uint32_t offset{0};
+        uint32_t length{0};
+    };
+
+    // A radix edge spans one or more segments, joined by '/'; children of
+    // one node differ in their first segment, which is what is searched
+    struct PathEdge {
+        Label label;
+        uint32_t first_length{0};
+        uint32_t target{0};
+    };
+
+    struct PathNode {
+        Range edges;
+        Range exact;  // Rules for a path ending here
+        Range below;  // Rules for this path and everything under it
+    };
+
+    struct HostEdge {
+        Label label;
+        uint32_t target{0};
+    };
+
+    struct HostNode {
+        Range edges;
+        uint32_t exact{kNone};      // Path trie for this host
+        uint32_t subdomain{kNone};  // Path trie for hosts below it
+    };
+
+    // Mutable tries the rules are inserted into before flattening
+    struct BuildPath {
+        std::map<std::string, std::unique_ptr<BuildPath>> children;
+        std::vector<RuleRef> exact;
+        std::vector<RuleRef> below;
+    };
+
+    struct BuildHost {
+        std::map<std::string, std::unique_ptr<BuildHost>> children;
+        std::unique_ptr<BuildPath> exact;
+        std::unique_ptr<BuildPath> subdomain;
+    };
+
+    explicit Compiled(const URLRuleSet& rules) : pattern_count(rules.size()) {
+        BuildHost root;
+        for (const URLRuleSet::Rule& rule : rules.rules_) {
+            BuildHost* host = &root;
+            for (const std::string& label : rule.host_labels) {
+                auto& child = host->children[label];
+                if (!child) child = std::make_unique<BuildHost>();
+                host = child.get();
+            }
+            auto& path_root = rule.any_subdomain ? host->subdomain : host->exact;
+            if (!path_root) path_root = std::make_unique<BuildPath>();
+            BuildPath* path = path_root.get();
+            for (const std::string& segment : rule.path_segments) {
+                auto& child = path->children[segment];
+                if (!child) child = std::make_unique<BuildPath>();
+                path = child.get();
+            }
+            (rule.any_path_below ? path->below : path->exact).push_back(RuleRef{rule.id, rule.scheme});
+        }
+        flatten(root);
+    }
+
+    Label add_label(std::string_view label) {
+        const Label result{static_cast<uint32_t>(text.size()), static_cast<uint32_t>(label.size())};
+        text.append(label);
+        return result;
+    }
+
+    std::string_view label(Label label) const noexcept { return {text.data() + label.offset, label.length}; }
+
+    Range add_rules(const std::vector<RuleRef>& refs) {
+        const Range range{static_cast<uint32_t>(rules.size()), static_cast<uint32_t>(rules.size() + refs.size())};
+        rules.insert(rules.end(), refs.begin(), refs.end());
+        return range;
+    }
+
+    uint32_t flatten(const BuildHost& build) {
+        const auto index = static_cast<uint32_t>(host_nodes.size());
+        host_nodes.emplace_back();
+        if (build.exact) host_nodes[index].exact = flatten(*build.exact);
+        if (build.subdomain) host_nodes[index].subdomain = flatten(*build.subdomain);
+
+        // Reserve the edge range first so it stays contiguous while the
+        // children append theirs
+        const auto begin = static_cast<uint32_t>(host_edges.size());
+        host_edges.resize(begin + build.children.size());
+        host_nodes[index].edges = {begin, static_cast<uint32_t>(host_edges.size())};
+        uint32_t edge = begin;
+        for (const auto& [name, child] : build.children) {
+            host_edges[edge].label = add_label(name);
+            host_edges[edge++].target = flatten(*child);
+        }
+        return index;
+    }
+
+    uint32_t flatten(const BuildPath& build) {
+        const auto index = static_cast<uint32_t>(path_nodes.size());
+        path_nodes.emplace_back();
+        path_nodes[index].exact = add_rules(build.exact);
+        path_nodes[index].below = add_rules(build.below);
+
+        const auto begin = static_cast<uint32_t>(path_edges.size());
+        path_edges.resize(begin + build.children.size());
+        path_nodes[index].edges = {begin, static_cast<uint32_t>(path_edges.size())};
+        uint32_t edge = begin;
+        for (const auto& [segment, child] : build.children) {
+            // Collapse a chain of rule-less single-child nodes into this edge
+            std::string joined = segment;
+            const BuildPath* end = child.get();
+            while (end->exact.empty() && end->below.empty() && end->children.size() == 1) {
+                joined += '/';
+                joined += end->children.begin()->first;
+                end = end->children.begin()->second.get();
+            }
+            path_edges[edge].label = add_label(joined);
+            path_edges[edge].first_length = static_cast<uint32_t>(segment.size());
+            path_edges[edge++].target = flatten(*end);
+        }
+        return index;
+    }
+
+    void collect(Range range, SchemeId scheme, std::vector<uint32_t>& out) const {
+        for (uint32_t i = range.begin; i < range.end; ++i) {
+            if (rules[i].scheme == SchemeId::unknown || rules[i].scheme == scheme) out.push_back(rules[i].id);
+        }
+    }
+
+    void match_path(uint32_t node, SchemeId scheme, std::string_view path, std::vector<uint32_t>& out) const {
+        if (!path.empty() && path.front() == '/') path.remove_prefix(1);
+        size_t pos = 0;
+        bool ended = false;  // Every segment consumed
+        for (;;) {
+            const PathNode& current = path_nodes[node];
+            collect(current.below, scheme, out);
+            if (ended) {
+                collect(current.exact, scheme, out);
+                return;
+            }
+
+            const std::string_view segment = path.substr(pos, path.find('/', pos) - pos);
+            const PathEdge* first = path_edges.data() + current.edges.begin;
+            const PathEdge* last = path_edges.data() + current.edges.end;
+            const PathEdge* edge = std::lower_bound(first, last, segment, [this](const PathEdge& e, std::string_view s) {
+                return label(e.label).substr(0, e.first_length) < s;
+            });
+            if (edge == last || label(edge->label).substr(0, edge->first_length) != segment) return;
+
+            // The rest of a collapsed edge must match whole segments too
+            const std::string_view joined = label(edge->label);
+            const size_t next = pos + joined.size();
+            if (joined.size() != segment.size()) {
+                if (path.compare(pos, joined.size(), joined) != 0) return;
+                if (next < path.size() && path[next] != '/') return;
+            }
+            if (next >= path.size()) ended = true;
+            else pos = next + 1;
+            node = edge->target;
+        }
+    }
+
+    void match(SchemeId scheme, std::string_view host, std::string_view path, std::vector<uint32_t>& out) const {
+        if (host_nodes.empty()) return;
+        if (!host.empty() && host.back() == '.') host.remove_suffix(1);  // Fully qualified form
+
+        // Labels are consumed right to left; [0, end) is what remains
+        uint32_t node = 0;
+        size_t end = host.size();
+        bool labels_left = !host.empty();
+        for (;;) {
+            const HostNode& current = host_nodes[node];
+            if (!labels_left) {
+                if (current.exact != kNone) match_path(current.exact, scheme, path, out);
+                return;
+            }
+            if (current.subdomain != kNone) match_path(current.subdomain, scheme, path, out);
+
+            const size_t dot = end == 0 ? std::string_view::npos : host.rfind('.', end - 1);
+            const size_t begin = dot == std::string_view::npos ? 0 : dot + 1;
+            const std::string_view name = host.substr(begin, end - begin);
+            const HostEdge* first = host_edges.data() + current.edges.begin;
+            const HostEdge* last = host_edges.data() + current.edges.end;
+            const HostEdge* edge = std::lower_bound(first, last, name, [this](const HostEdge& e, std::string_view n) {
+                return compare_folded(label(e.label), n) < 0;
+            });
+            if (edge == last || compare_folded(label(edge->label), name) != 0) return;
+
+            node = edge->target;
+            labels_left = dot != std::string_view::npos;
+            end = labels_left ? dot : 0;
+        }
+    }
+
+    std::string text;
+    std::vector<HostNode> host_nodes;
+    std::vector<HostEdge> host_edges;
+    std::vector<PathNode> path_nodes;
+    std::vector<PathEdge> path_edges;
+    std::vector<RuleRef> rules;
+    size_t pattern_count;
+};
+
+// Pins the current rule set for the guard's lifetime. The count is raised
+// before the set is confirmed current, so a reload that finds all counts
+// of a slot at zero knows no reader can still reach the set in it.
+class URLMatcher::ReadGuard {
+public:
+    explicit ReadGuard(const URLMatcher& matcher) noexcept : stripe_(thread_stripe() % kStripes) {
+        for (;;) {
+            slot_ = matcher.current_.load();
+            count_ = &matcher.readers_[slot_][stripe_].value;
+            count_->fetch_add(1);
+            if (matcher.current_.load() == slot_) break;
+            count_->fetch_sub(1, std::memory_order_release);
+        }
+        set_ = matcher.sets_[slot_].get();
+    }
+
+    ~ReadGuard() { count_->fetch_sub(1, std::memory_order_release); }
+
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+
+    const Compiled& set() const noexcept { return *set_; }
+
+private:
+    size_t stripe_;
+    unsigned slot_{0};
+    std::atomic<uint32_t>* count_{nullptr};
+    const Compiled* set_{nullptr};
+};
+
+URLMatcher::URLMatcher() : URLMatcher(URLRuleSet{}) {}
+
+URLMatcher::URLMatcher(const URLRuleSet& rules) {
+    sets_[0] = std::make_unique<const Compiled>(rules);
+}
+
+URLMatcher::~URLMatcher() = default;
+
+void URLMatcher::reload(const URLRuleSet& rules) {
+    SEEDLIB_TRACE_SPAN("matcher.reload");
+    auto compiled = std::make_unique<const Compiled>(rules);
+
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+    const unsigned next = 1 - current_.load();
+    // Readers of the set before last; new readers cannot reach it
+    for (const ReaderCount& count : readers_[next]) {
+        while (count.value.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+    }
+    sets_[next] = std::move(compiled);
+    current_.store(next);
+}
+
+std::vector<uint32_t> URLMatcher::match(const URLView& url) const {
+    std::vector<uint32_t> ids;
+    match(url, ids);
+    return ids;
+}
+
+std::vector<uint32_t> URLMatcher::match(const URL& url) const {
+    std::vector<uint32_t> ids;
+    match(url, ids);
+    return ids;
+}
+
+void URLMatcher::match(const URLView& url, std::vector<uint32_t>& out) const {
+    match(url.scheme_id(), url.host(), url.path(), out);
+}
+
+void URLMatcher::match(const URL& url, std::vector<uint32_t>& out) const {
+    match(url.scheme_id(), url.host(), url.path(), out);
+}
+
+void URLMatcher::match(SchemeId scheme, std::string_view host, std::string_view path,
+                       std::vector<uint32_t>& out) const {
+    out.clear();
+    {
+        const ReadGuard guard(*this);
+        guard.set().match(scheme, host, path, out);
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+size_t URLMatcher::size() const noexcept {
+    const ReadGuard guard(*this);
+    return guard.set().pattern_count;
+}
+
+} // namespace seedlib
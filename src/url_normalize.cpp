@@ -0,0 +1,305 @@
+// src/url_normalize.cpp
+#include "seedlib/url.hpp"
+#include "seedlib/detail/url_impl.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace seedlib {
+
+namespace {
+    constexpr char hex_digits[] = "0123456789ABCDEF";
+
+    inline int hex_value(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    inline bool is_unreserved(unsigned char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+               c == '-' || c == '.' || c == '_' || c == '~';
+    }
+
+    // Writes normalized bytes over the source; output never outruns input
+    struct BufferSink {
+        char* out;
+        void put(char c) { *out++ = c; }
+        void put(const char* first, size_t count) {
+            std::memmove(out, first, count);
+            out += count;
+        }
+    };
+
+    // Streaming 64-bit hash fed one byte at a time, mixed per 8-byte word
+    class HashSink {
+    public:
+        void put(char c) {
+            word_ |= uint64_t{static_cast<unsigned char>(c)} << (8 * filled_);
+            ++length_;
+            if (++filled_ == 8) flush();
+        }
+
+        // Whole words go straight to the mixer once the pending word is full
+        void put(const char* first, size_t count) {
+            while (count != 0 && filled_ != 0) {
+                put(*first++);
+                --count;
+            }
+            for (; count >= 8; first += 8, count -= 8) {
+                uint64_t word = 0;
+                for (int i = 0; i < 8; ++i) word |= uint64_t{static_cast<unsigned char>(first[i])} << (8 * i);
+                word_ = word;
+                length_ += 8;
+                flush();
+            }
+            while (count-- != 0) put(*first++);
+        }
+
+        uint64_t finish() {
+            if (filled_ != 0) flush();
+            return fmix(state_ ^ length_);
+        }
+
+    private:
+        static uint64_t fmix(uint64_t x) {
+            x ^= x >> 30;
+            x *= 0xBF58476D1CE4E5B9ULL;
+            x ^= x >> 27;
+            x *= 0x94D049BB133111EBULL;
+            x ^= x >> 31;
+            return x;
+        }
+
+        void flush() {
+            const uint64_t mixed = fmix(word_ + 0x9E3779B97F4A7C15ULL);
+            state_ = ((state_ ^ mixed) << 27 | (state_ ^ mixed) >> 37) * 0x9FB21C651E98DF25ULL;
+            word_ = 0;
+            filled_ = 0;
+        }
+
+        uint64_t state_{0x243F6A8885A308D3ULL};
+        uint64_t word_{0};
+        uint64_t length_{0};
+        unsigned filled_{0};
+    };
+
+    // RFC 3986 6.2.2.1-2: uppercase escape hex, decode escaped unreserved
+    // characters, and optionally lowercase everything else (hosts)
+    template <typename Sink>
+    void emit_normalized(std::string_view text, Sink& sink, bool lowercase = false) {
+        const char* p = text.data();
+        const char* const end = p + text.size();
+        while (p != end) {
+            if (!lowercase && *p != '%') {
+                // Copy the run up to the next escape as is
+                const void* escape = std::memchr(p, '%', static_cast<size_t>(end - p));
+                const char* run_end = escape ? static_cast<const char*>(escape) : end;
+                sink.put(p, static_cast<size_t>(run_end - p));
+                p = run_end;
+            } else if (*p == '%' && end - p >= 3 && hex_value(p[1]) >= 0 && hex_value(p[2]) >= 0) {
+                const auto value = static_cast<unsigned char>((hex_value(p[1]) << 4) | hex_value(p[2]));
+                if (is_unreserved(value)) {
+                    sink.put(lowercase ? detail::ascii_lower(static_cast<char>(value))
+                                       : static_cast<char>(value));
+                } else {
+                    sink.put('%');
+                    sink.put(hex_digits[value >> 4]);
+                    sink.put(hex_digits[value & 0x0F]);
+                }
+                p += 3;
+            } else {
+                sink.put(lowercase ? detail::ascii_lower(*p) : *p);
+                ++p;
+            }
+        }
+    }
+
+    // "." and ".." segments, spelled literally or with %2E
+    int dot_count(std::string_view segment) {
+        int dots = 0;
+        for (size_t i = 0; i < segment.size();) {
+            if (segment[i] == '.') {
+                i += 1;
+            } else if (segment.size() - i >= 3 && segment[i] == '%' && segment[i + 1] == '2' &&
+                       (segment[i + 2] == 'e' || segment[i + 2] == 'E')) {
+                i += 3;
+            } else {
+                return 0;
+            }
+            if (++dots > 2) return 0;
+        }
+        return dots;
+    }
+
+    // Segment stack that stays on the stack for typical path depths
+    class SegmentStack {
+    public:
+        bool empty() const { return size_ == 0; }
+        void pop_back() { --size_; }
+        void push_back(std::string_view segment) {
+            if (size_ < kInline) {
+                inline_[size_] = segment;
+            } else {
+                overflow_.resize(size_ - kInline);
+                overflow_.push_back(segment);
+            }
+            ++size_;
+        }
+        std::string_view operator[](size_t i) const { return i < kInline ? inline_[i] : overflow_[i - kInline]; }
+        size_t size() const { return size_; }
+
+    private:
+        static constexpr size_t kInline = 32;
+        std::string_view inline_[kInline];
+        std::vector<std::string_view> overflow_;
+        size_t size_{0};
+    };
+
+    // RFC 3986 5.2.4 over segment boundaries: the kept segments are
+    // collected first, then emitted in order with escapes normalized
+    template <typename Sink>
+    void emit_path(std::string_view path, Sink& sink) {
+        if (path.empty()) return;
+        if (path[0] != '/') {
+            emit_normalized(path, sink);
+            return;
+        }
+
+        SegmentStack kept;
+        size_t start = 1;
+        for (;;) {
+            const size_t slash = path.find('/', start);
+            const bool last = slash == std::string_view::npos;
+            const std::string_view segment = path.substr(start, last ? std::string_view::npos : slash - start);
+
+            const int dots = dot_count(segment);
+            if (dots == 2 && !kept.empty()) {
+                kept.pop_back();
+            } else if (dots == 0) {
+                kept.push_back(segment);
+            }
+            if (last) {
+                // A trailing "." or ".." leaves a trailing slash
+                if (dots != 0) kept.push_back({});
+                break;
+            }
+            start = slash + 1;
+        }
+
+        for (size_t i = 0; i < kept.size(); ++i) {
+            sink.put('/');
+            emit_normalized(kept[i], sink);
+        }
+        if (kept.empty()) sink.put('/');
+    }
+
+    // Normalized query with pairs stably sorted by normalized key
+    std::string sorted_query(std::string_view query) {
+        std::string normalized(query.size(), '\0');
+        BufferSink sink{normalized.data()};
+        emit_normalized(query, sink);
+        normalized.resize(static_cast<size_t>(sink.out - normalized.data()));
+
+        // Each pair runs from its key to the next '&', so "k=" keeps its '='
+        const char* const query_end = normalized.data() + normalized.size();
+        std::vector<std::string_view> pairs;
+        for (const auto& param : QueryParams(normalized)) {
+            const char* begin = param.key.data();
+            const void* amp = std::memchr(begin, '&', static_cast<size_t>(query_end - begin));
+            const char* end = amp ? static_cast<const char*>(amp) : query_end;
+            pairs.emplace_back(begin, static_cast<size_t>(end - begin));
+        }
+        std::stable_sort(pairs.begin(), pairs.end(), [](std::string_view a, std::string_view b) {
+            return a.substr(0, a.find('=')) < b.substr(0, b.find('='));
+        });
+
+        std::string result;
+        result.reserve(normalized.size());
+        for (auto pair : pairs) {
+            if (!result.empty()) result += '&';
+            result += pair;
+        }
+        return result;
+    }
+}
+
+void URL::normalize(const NormalizeOptions& options) {
+    auto rewrite = [this](URLImpl::Component component, auto&& emit) {
+        char* begin = impl_->data(component);
+        BufferSink sink{begin};
+        emit(impl_->get(component), sink);
+        const auto length = static_cast<uint32_t>(sink.out - begin);
+        // Normalizing only shrinks text, so this never reallocates
+        URLImpl::splice(impl_.get(), component, length, impl_->spans[component].length - length, {});
+    };
+
+    // A shared interned host is left alone unless it needs rewriting
+    const std::string_view interned = impl_->interned_host;
+    const bool interned_is_canonical =
+        interned.data() && std::none_of(interned.begin(), interned.end(), [](char c) {
+            return c == '%' || (c >= 'A' && c <= 'Z');
+        });
+    if (!interned_is_canonical) {
+        if (interned.data()) {
+            patch(URLImpl::kHost, interned);
+            impl_->interned_host = {};
+        }
+        rewrite(URLImpl::kHost, [](std::string_view text, BufferSink& sink) { emit_normalized(text, sink, true); });
+    }
+    if (path().empty() && scheme_info(impl_->scheme_id).special) {
+        patch(URLImpl::kPath, "/");
+    } else {
+        rewrite(URLImpl::kPath, [](std::string_view text, BufferSink& sink) { emit_path(text, sink); });
+    }
+    if (options.sort_query) {
+        patch(URLImpl::kQuery, sorted_query(query()));
+    } else {
+        rewrite(URLImpl::kQuery, [](std::string_view text, BufferSink& sink) { emit_normalized(text, sink); });
+    }
+    rewrite(URLImpl::kFragment, [](std::string_view text, BufferSink& sink) { emit_normalized(text, sink); });
+}
+
+// Hashes exactly the bytes to_string() would produce after normalize()
+uint64_t URL::canonical_hash(const NormalizeOptions& options) const {
+    HashSink hash;
+    auto put = [&hash](std::string_view text) { hash.put(text.data(), text.size()); };
+
+    put(scheme());
+    put("://");
+    emit_normalized(host(), hash, true);
+
+    char port_buffer[5];
+    if (const std::string_view port = port_text(port_buffer); !port.empty()) {
+        hash.put(':');
+        put(port);
+    }
+
+    if (path().empty() && scheme_info(impl_->scheme_id).special) {
+        hash.put('/');
+    } else {
+        emit_path(path(), hash);
+    }
+
+    if (options.sort_query) {
+        const std::string sorted = sorted_query(query());
+        if (!sorted.empty()) {
+            hash.put('?');
+            put(sorted);
+        }
+    } else if (!query().empty()) {
+        hash.put('?');
+        emit_normalized(query(), hash);
+    }
+
+    if (!fragment().empty()) {
+        hash.put('#');
+        emit_normalized(fragment(), hash);
+    }
+
+    return hash.finish();
+}
+
+} // namespace seedlib
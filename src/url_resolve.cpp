@@ -0,0 +1,238 @@
+// src/url_resolve.cpp
+#include "seedlib/url.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace seedlib {
+
+namespace {
+    inline bool is_alpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+
+    inline bool is_scheme_char(char c) {
+        return is_alpha(c) || (c >= '0' && c <= '9') || c == '+' || c == '-' || c == '.';
+    }
+
+    // Component boundaries of a URI reference (RFC 3986 Appendix B); no
+    // validation, that happens when the target is scanned
+    struct Reference {
+        std::string_view scheme;
+        std::string_view authority;
+        std::string_view path;
+        std::string_view query;
+        std::string_view fragment;
+        bool has_scheme{false};
+        bool has_authority{false};
+        bool has_query{false};
+        bool has_fragment{false};
+    };
+
+    Reference split_reference(std::string_view ref) {
+        Reference r;
+        size_t p = 0;
+
+        if (!ref.empty() && is_alpha(ref[0])) {
+            size_t i = 1;
+            while (i < ref.size() && is_scheme_char(ref[i])) ++i;
+            if (i < ref.size() && ref[i] == ':') {
+                r.scheme = ref.substr(0, i);
+                r.has_scheme = true;
+                p = i + 1;
+            }
+        }
+
+        if (ref.size() - p >= 2 && ref[p] == '/' && ref[p + 1] == '/') {
+            const size_t end = ref.find_first_of("/?#", p + 2);
+            r.authority = ref.substr(p + 2, end == std::string_view::npos ? std::string_view::npos : end - p - 2);
+            r.has_authority = true;
+            p = end == std::string_view::npos ? ref.size() : end;
+        }
+
+        const size_t path_end = std::min(ref.find_first_of("?#", p), ref.size());
+        r.path = ref.substr(p, path_end - p);
+        p = path_end;
+
+        if (p < ref.size() && ref[p] == '?') {
+            const size_t end = std::min(ref.find('#', p), ref.size());
+            r.query = ref.substr(p + 1, end - p - 1);
+            r.has_query = true;
+            p = end;
+        }
+
+        if (p < ref.size()) {
+            r.fragment = ref.substr(p + 1);
+            r.has_fragment = true;
+        }
+        return r;
+    }
+
+    // RFC 3986 5.2.4 in place; the output never outruns the input, and
+    // returns the new length
+    size_t remove_dot_segments(char* path, size_t length) {
+        char* in = path;
+        char* const end = path + length;
+        char* out = path;
+
+        auto pop_segment = [&] {
+            while (out > path) {
+                if (*--out == '/') break;
+            }
+        };
+
+        while (in < end) {
+            const size_t left = static_cast<size_t>(end - in);
+            if (left >= 3 && in[0] == '.' && in[1] == '.' && in[2] == '/') {  // A
+                in += 3;
+            } else if (left >= 2 && in[0] == '.' && in[1] == '/') {
+                in += 2;
+            } else if (left >= 3 && in[0] == '/' && in[1] == '.' && in[2] == '/') {  // B
+                in += 2;
+            } else if (left == 2 && in[0] == '/' && in[1] == '.') {
+                in[1] = '/';
+                in += 1;
+            } else if (left >= 4 && in[0] == '/' && in[1] == '.' && in[2] == '.' && in[3] == '/') {  // C
+                in += 3;
+                pop_segment();
+            } else if (left == 3 && in[0] == '/' && in[1] == '.' && in[2] == '.') {
+                in[2] = '/';
+                in += 2;
+                pop_segment();
+            } else if ((left == 1 && in[0] == '.') || (left == 2 && in[0] == '.' && in[1] == '.')) {  // D
+                in = end;
+            } else {  // E: move the first segment, with its leading "/", to the output
+                do {
+                    *out++ = *in++;
+                } while (in < end && *in != '/');
+            }
+        }
+        return static_cast<size_t>(out - path);
+    }
+
+    // Base components, gathered once per base
+    struct Base {
+        std::string_view scheme;
+        std::string_view host;
+        std::string_view port;  // Empty when default
+        std::string_view path;
+        std::string_view query;
+        std::string_view directory;  // path up to and including its last "/"
+    };
+
+    // Assembles the target of 5.2.2 into out and returns its length; out
+    // must hold target_bound(base, ref) bytes
+    size_t build_target(const Base& base, const Reference& r, char* out) {
+        char* p = out;
+        auto put = [&p](std::string_view text) {
+            if (!text.empty()) std::memcpy(p, text.data(), text.size());
+            p += text.size();
+        };
+
+        // scheme ":" [ "//" authority ]
+        put(r.has_scheme ? r.scheme : base.scheme);
+        put(":");
+        if (r.has_authority) {
+            put("//");
+            put(r.authority);
+        } else if (!r.has_scheme) {
+            put("//");
+            put(base.host);
+            if (!base.port.empty()) {
+                put(":");
+                put(base.port);
+            }
+        }
+
+        // path, with dot segments removed in place
+        char* const path = p;
+        bool from_base = false;
+        if (r.has_scheme || r.has_authority || (!r.path.empty() && r.path[0] == '/')) {
+            put(r.path);
+        } else if (r.path.empty()) {
+            put(base.path);
+            from_base = true;
+        } else {
+            // 5.2.3 merge: an authority with an empty base path implies "/"
+            put(base.directory.empty() ? std::string_view("/") : base.directory);
+            put(r.path);
+        }
+        if (!from_base) p = path + remove_dot_segments(path, static_cast<size_t>(p - path));
+
+        const bool keep_base_query = from_base && !r.has_query;
+        if (keep_base_query ? !base.query.empty() : r.has_query) {
+            put("?");
+            put(keep_base_query ? base.query : r.query);
+        }
+        if (r.has_fragment) {
+            put("#");
+            put(r.fragment);
+        }
+        return static_cast<size_t>(p - out);
+    }
+
+    size_t target_bound(const Base& base, std::string_view ref) {
+        // Every piece of the target comes from base or ref, plus delimiters
+        return base.scheme.size() + base.host.size() + base.port.size() + base.path.size() +
+               base.query.size() + ref.size() + 8;
+    }
+
+    Base make_base(const URL& url, char (&port_buffer)[5]) {
+        Base base;
+        base.scheme = url.scheme();
+        base.host = url.host();
+        if (uint16_t port = url.port(); port != 0 && port != scheme_info(url.scheme_id()).default_port) {
+            char* digits = port_buffer + sizeof(port_buffer);
+            do {
+                *--digits = static_cast<char>('0' + port % 10);
+                port /= 10;
+            } while (port != 0);
+            base.port = std::string_view(digits, static_cast<size_t>(port_buffer + sizeof(port_buffer) - digits));
+        }
+        base.path = url.path();
+        base.query = url.query();
+        base.directory = base.path.substr(0, base.path.rfind('/') + 1);
+        return base;
+    }
+
+    std::optional<URL> resolve_one(const Base& base, std::string_view ref, URLError& error) {
+        const Reference r = split_reference(ref);
+
+        // Small targets are built on the stack, so the only allocation is
+        // the resulting URL's own block
+        char stack_buffer[1024];
+        std::string heap_buffer;
+        char* buffer = stack_buffer;
+        const size_t bound = target_bound(base, ref);
+        if (bound > sizeof(stack_buffer)) {
+            heap_buffer.resize(bound);
+            buffer = heap_buffer.data();
+        }
+
+        const size_t length = build_target(base, r, buffer);
+        return URL::try_parse(std::string_view(buffer, length), error);
+    }
+}
+
+std::optional<URL> URL::try_resolve(std::string_view ref, URLError& error) const {
+    char port_buffer[5];
+    return resolve_one(make_base(*this, port_buffer), ref, error);
+}
+
+std::optional<URL> URL::resolve(std::string_view ref) const {
+    URLError error;
+    return try_resolve(ref, error);
+}
+
+std::vector<std::optional<URL>> URL::resolve(const std::vector<std::string_view>& refs) const {
+    char port_buffer[5];
+    const Base base = make_base(*this, port_buffer);
+
+    std::vector<std::optional<URL>> results;
+    results.reserve(refs.size());
+    URLError error;
+    for (auto ref : refs) {
+        results.push_back(resolve_one(base, ref, error));
+    }
+    return results;
+}
+
+} // namespace seedlib
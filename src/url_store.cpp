@@ -0,0 +1,300 @@
+// src/url_store.cpp
+#include "seedlib/url_store.hpp"
+#include "seedlib/host_interner.hpp"
+#include "seedlib/tracing.hpp"
+#include "seedlib/url.hpp"
+#include "seedlib/url_batch.hpp"
+#include <SQLiteCpp/SQLiteCpp.h>
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <unordered_map>
+
+namespace seedlib {
+
+namespace {
+    constexpr const char* kSchema = R"sql(
+        CREATE TABLE IF NOT EXISTS hosts (
+            id INTEGER PRIMARY KEY,
+            name TEXT NOT NULL UNIQUE
+        );
+        CREATE TABLE IF NOT EXISTS urls (
+            id INTEGER PRIMARY KEY,
+            scheme_id INTEGER NOT NULL,
+            scheme TEXT NOT NULL DEFAULT '',
+            host_id INTEGER NOT NULL REFERENCES hosts(id),
+            port INTEGER NOT NULL,
+            path TEXT NOT NULL,
+            query TEXT NOT NULL,
+            status INTEGER NOT NULL DEFAULT 0
+        );
+        CREATE UNIQUE INDEX IF NOT EXISTS urls_location ON urls (host_id, path, query, port, scheme_id, scheme);
+    )sql";
+
+    // Bits of the find() statement cache
+    constexpr unsigned kByHost = 1;
+    constexpr unsigned kByPrefix = 2;
+    constexpr unsigned kPrefixBound = 4;
+    constexpr unsigned kByStatus = 8;
+
+    void assign_lower(std::string& out, std::string_view text) {
+        out.resize(text.size());
+        std::transform(text.begin(), text.end(), out.begin(), detail::ascii_lower);
+    }
+
+    // Smallest string above every string starting with prefix, so a prefix
+    // match is a range the (host, path) index can serve. LIKE would not do:
+    // it folds case and SQLite only indexes it under case_sensitive_like.
+    // False when there is no such bound (the prefix is all 0xFF bytes).
+    bool prefix_upper_bound(std::string_view prefix, std::string& out) {
+        out.assign(prefix);
+        while (!out.empty() && static_cast<unsigned char>(out.back()) == 0xFF) out.pop_back();
+        if (out.empty()) return false;
+        out.back() = static_cast<char>(static_cast<unsigned char>(out.back()) + 1);
+        return true;
+    }
+
+    std::string find_sql(unsigned flags) {
+        std::string sql = "SELECT u.id, u.scheme_id, u.scheme, h.name, u.port, u.path, u.query, u.status "
+                          "FROM urls u JOIN hosts h ON h.id = u.host_id WHERE 1";
+        if (flags & kByHost) sql += " AND u.host_id = :host";
+        if (flags & kByPrefix) sql += " AND u.path >= :prefix";
+        if (flags & kPrefixBound) sql += " AND u.path < :bound";
+        if (flags & kByStatus) sql += " AND u.status = :status";
+        sql += (flags & kByHost) ? " ORDER BY u.path, u.query" : " ORDER BY u.host_id, u.path, u.query";
+        return sql + " LIMIT :limit";
+    }
+
+    // Returns a statement to its initial state however the scope exits, so
+    // a failed step leaves it neither unusable nor holding a read lock
+    class ScopedReset {
+    public:
+        explicit ScopedReset(SQLite::Statement& statement) noexcept : statement_(statement) {}
+        ~ScopedReset() { statement_.tryReset(); }
+
+        ScopedReset(const ScopedReset&) = delete;
+        ScopedReset& operator=(const ScopedReset&) = delete;
+
+    private:
+        SQLite::Statement& statement_;
+    };
+
+    // The database with its pragmas applied and the schema created, which
+    // must precede preparing any statement against it
+    struct Connection {
+        Connection(const std::string& path, const URLStoreOptions& options)
+            : db(path, SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE, options.busy_timeout_ms) {
+            if (options.wal) {
+                // NORMAL is durable in WAL mode except against power loss,
+                // and skips the fsync per commit
+                db.exec("PRAGMA journal_mode = WAL");
+                db.exec("PRAGMA synchronous = NORMAL");
+            }
+            db.exec(kSchema);
+        }
+
+        SQLite::Database db;
+    };
+}
+
+struct URLStore::Impl {
+    Impl(const std::string& path, const URLStoreOptions& opts)
+        : options(opts),
+          connection(path, opts),
+          insert_url(db, "INSERT OR IGNORE INTO urls (scheme_id, scheme, host_id, port, path, query, status) "
+                         "VALUES (?, ?, ?, ?, ?, ?, ?)"),
+          insert_host(db, "INSERT INTO hosts (name) VALUES (?)"),
+          select_host(db, "SELECT id FROM hosts WHERE name = ?"),
+          update_status(db, "UPDATE urls SET status = ? WHERE id = ?"),
+          count_urls(db, "SELECT count(*) FROM urls") {}
+
+    // Host id for the lowercased host, creating the row if asked to;
+    // -1 if it is unknown and create is false
+    int64_t host_id(std::string_view host, bool create) {
+        assign_lower(host_text, host);
+        if (const std::string_view interned = interner.find(host_text); interned.data()) {
+            if (auto it = host_ids.find(interned.data()); it != host_ids.end()) return it->second;
+        }
+
+        int64_t id = -1;
+        {
+            ScopedReset reset(select_host);
+            select_host.bind(1, host_text);
+            if (select_host.executeStep()) id = select_host.getColumn(0).getInt64();
+        }
+        if (id < 0) {
+            if (!create) return -1;
+            ScopedReset reset(insert_host);
+            insert_host.bind(1, host_text);
+            insert_host.exec();
+            id = db.getLastInsertRowid();
+        }
+        host_ids[interner.intern(host_text).data()] = id;
+        return id;
+    }
+
+    bool insert(const URLView& url, int status) {
+        const SchemeId scheme_id = url.scheme_id();
+        if (scheme_id == SchemeId::unknown) assign_lower(scheme_text, url.scheme());
+        else scheme_text.clear();
+        path_text.assign(url.path());
+        query_text.assign(url.query());
+
+        const int64_t host = host_id(url.host(), true);
+        ScopedReset reset(insert_url);
+        insert_url.bind(1, static_cast<int32_t>(scheme_id));
+        insert_url.bind(2, scheme_text);
+        insert_url.bind(3, host);
+        insert_url.bind(4, static_cast<int32_t>(url.port()));
+        insert_url.bind(5, path_text);
+        insert_url.bind(6, query_text);
+        insert_url.bind(7, static_cast<int32_t>(status));
+        return insert_url.exec() > 0;
+    }
+
+    // Host rows created inside a rolled back transaction are gone, so
+    // their cached ids must be too
+    template <typename Body>
+    auto transaction(Body body) {
+        try {
+            SQLite::Transaction transaction(db);
+            auto result = body();
+            transaction.commit();
+            return result;
+        } catch (...) {
+            host_ids.clear();
+            throw;
+        }
+    }
+
+    SQLite::Statement& find_statement(unsigned flags) {
+        auto& statement = find_statements[flags];
+        if (!statement) statement = std::make_unique<SQLite::Statement>(db, find_sql(flags));
+        return *statement;
+    }
+
+    URLStoreOptions options;
+    Connection connection;
+    SQLite::Database& db{connection.db};
+    SQLite::Statement insert_url;
+    SQLite::Statement insert_host;
+    SQLite::Statement select_host;
+    SQLite::Statement update_status;
+    SQLite::Statement count_urls;
+    std::array<std::unique_ptr<SQLite::Statement>, 16> find_statements;
+
+    HostInterner interner{1};
+    std::unordered_map<const char*, int64_t> host_ids;  // Keyed by interned data pointer
+
+    // Reused bind buffers, so inserts stop allocating once warmed up
+    std::string host_text;
+    std::string scheme_text;
+    std::string path_text;
+    std::string query_text;
+    std::string bound_text;
+};
+
+std::string StoredURL::href() const {
+    std::string result;
+    result.reserve(scheme.size() + host.size() + path.size() + query.size() + 10);
+    result.append(scheme).append("://").append(host);
+    if (port != 0 && port != scheme_info(scheme_id).default_port) result.append(":").append(std::to_string(port));
+    result.append(path);
+    if (!query.empty()) result.append("?").append(query);
+    return result;
+}
+
+URLStore::URLStore(const std::string& path, const URLStoreOptions& options)
+    : impl_(std::make_unique<Impl>(path, options)) {}
+
+URLStore::~URLStore() = default;
+URLStore::URLStore(URLStore&& other) noexcept = default;
+URLStore& URLStore::operator=(URLStore&& other) noexcept = default;
+
+size_t URLStore::insert(const URLBatch& batch, int status) {
+    SEEDLIB_TRACE_SPAN("store.insert");
+    const size_t per_transaction =
+        impl_->options.rows_per_transaction ? impl_->options.rows_per_transaction : batch.size();
+    size_t inserted = 0;
+    for (size_t begin = 0; begin < batch.size(); begin += per_transaction) {
+        const size_t end = std::min(batch.size(), begin + per_transaction);
+        inserted += impl_->transaction([&] {
+            size_t added = 0;
+            for (size_t i = begin; i < end; ++i) {
+                if (batch.valid(i)) added += impl_->insert(batch.view(i), status) ? 1 : 0;
+            }
+            return added;
+        });
+    }
+    return inserted;
+}
+
+bool URLStore::insert(const URLView& url, int status) {
+    return impl_->transaction([&] { return impl_->insert(url, status); });
+}
+
+std::vector<StoredURL> URLStore::find(const URLStoreQuery& query) {
+    SEEDLIB_TRACE_SPAN("store.find");
+    std::vector<StoredURL> rows;
+    int64_t host_id = -1;
+    if (!query.host.empty()) {
+        host_id = impl_->host_id(query.host, false);
+        if (host_id < 0) return rows;
+    }
+
+    unsigned flags = 0;
+    if (host_id >= 0) flags |= kByHost;
+    if (!query.path_prefix.empty()) {
+        flags |= kByPrefix;
+        if (prefix_upper_bound(query.path_prefix, impl_->bound_text)) flags |= kPrefixBound;
+    }
+    if (query.status >= 0) flags |= kByStatus;
+
+    SQLite::Statement& statement = impl_->find_statement(flags);
+    ScopedReset reset(statement);
+    int index = 1;
+    if (flags & kByHost) statement.bind(index++, host_id);
+    if (flags & kByPrefix) {
+        impl_->path_text.assign(query.path_prefix);
+        statement.bind(index++, impl_->path_text);
+    }
+    if (flags & kPrefixBound) statement.bind(index++, impl_->bound_text);
+    if (flags & kByStatus) statement.bind(index++, static_cast<int32_t>(query.status));
+    statement.bind(index, query.limit ? static_cast<int64_t>(query.limit) : int64_t{-1});
+
+    while (statement.executeStep()) {
+        StoredURL row;
+        row.id = statement.getColumn(0).getInt64();
+        const int scheme_id = statement.getColumn(1).getInt();
+        if (scheme_id > 0 && static_cast<size_t>(scheme_id) < std::size(scheme_table)) {
+            row.scheme_id = static_cast<SchemeId>(scheme_id);
+            row.scheme = scheme_info(row.scheme_id).name;
+        } else {
+            row.scheme = statement.getColumn(2).getString();
+        }
+        row.host = statement.getColumn(3).getString();
+        row.port = static_cast<uint16_t>(statement.getColumn(4).getInt());
+        row.path = statement.getColumn(5).getString();
+        row.query = statement.getColumn(6).getString();
+        row.status = statement.getColumn(7).getInt();
+        rows.push_back(std::move(row));
+    }
+    return rows;
+}
+
+bool URLStore::set_status(int64_t id, int status) {
+    SQLite::Statement& statement = impl_->update_status;
+    ScopedReset reset(statement);
+    statement.bind(1, static_cast<int32_t>(status));
+    statement.bind(2, id);
+    return statement.exec() > 0;
+}
+
+size_t URLStore::size() {
+    SQLite::Statement& statement = impl_->count_urls;
+    ScopedReset reset(statement);
+    statement.executeStep();
+    return static_cast<size_t>(statement.getColumn(0).getInt64());
+}
+
+} // namespace seedlib
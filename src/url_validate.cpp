@@ -0,0 +1,361 @@
+// src/url_validate.cpp
+#include "seedlib/url.hpp"
+#include "seedlib/detail/simd_scan.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace seedlib {
+
+namespace {
+    // RFC 3986 Appendix A sets, one bit per component. '%' is in none of
+    // them: simd::skip_escaped checks escapes as it skips.
+    enum ValidClass : uint8_t {
+        kSchemeChar = 1 << 0,  // ALPHA / DIGIT / "+" / "-" / "."
+        kRegName    = 1 << 1,  // unreserved / sub-delims
+        kPathChar   = 1 << 2,  // pchar / "/"
+        kQueryChar  = 1 << 3,  // pchar / "/" / "?"
+        kAlphaChar  = 1 << 4,
+        kDigitChar  = 1 << 5,
+        kDomainChar = 1 << 6,  // WHATWG: not a forbidden domain code point
+    };
+
+    constexpr std::array<uint8_t, 256> make_valid_table() {
+        std::array<uint8_t, 256> table{};
+        constexpr uint8_t unreserved = kRegName | kPathChar | kQueryChar;
+        for (int c = 'a'; c <= 'z'; ++c) table[c] |= unreserved | kSchemeChar | kAlphaChar;
+        for (int c = 'A'; c <= 'Z'; ++c) table[c] |= unreserved | kSchemeChar | kAlphaChar;
+        for (int c = '0'; c <= '9'; ++c) table[c] |= unreserved | kSchemeChar | kDigitChar;
+        for (unsigned char c : std::string_view("-._~")) table[c] |= unreserved;
+        for (unsigned char c : std::string_view("!$&'()*+,;=")) table[c] |= unreserved;
+        for (unsigned char c : std::string_view("+-.")) table[c] |= kSchemeChar;
+        table[':'] |= kPathChar | kQueryChar;
+        table['@'] |= kPathChar | kQueryChar;
+        table['/'] |= kPathChar | kQueryChar;
+        table['?'] |= kQueryChar;
+
+        // '%' stays in: the parser decodes escapes before this check, and
+        // non-ASCII bytes are left to IDNA
+        for (int c = 0x21; c < 0x100; ++c) table[c] |= kDomainChar;
+        for (unsigned char c : std::string_view("#/:<>?@[\\]^|\x7F")) table[c] &= ~kDomainChar;
+        return table;
+    }
+
+    constexpr auto valid_table = make_valid_table();
+
+    constexpr bool is(char c, uint8_t classes) {
+        return (valid_table[static_cast<unsigned char>(c)] & classes) != 0;
+    }
+
+    // The component sets for simd::skip_escaped, which checks escapes in
+    // the same pass; all hold the hex digits, as it requires
+    constexpr simd::ByteClass kRegNameClass = simd::make_byte_class([](char c) { return is(c, kRegName); });
+    constexpr simd::ByteClass kPathClass = simd::make_byte_class([](char c) { return is(c, kPathChar); });
+    constexpr simd::ByteClass kQueryClass = simd::make_byte_class([](char c) { return is(c, kQueryChar); });
+
+    constexpr bool holds_hex(const simd::ByteClass& allowed) {
+        for (char c : std::string_view("0123456789abcdefABCDEF")) {
+            if (!allowed.contains(c)) return false;
+        }
+        return true;
+    }
+    static_assert(holds_hex(kRegNameClass) && holds_hex(kPathClass) && holds_hex(kQueryClass));
+
+    // Walks [p, end) while characters are allowed or well-formed escapes,
+    // a vector at a time; returns where it stopped, or nullptr after a bad
+    // escape (with bad set to the '%')
+    const char* skip_component(const char* p, const char* end, const simd::ByteClass& allowed, const char*& bad) {
+        p = simd::skip_escaped(p, end, allowed);
+        if (p != end && *p == '%') {
+            bad = p;
+            return nullptr;
+        }
+        return p;
+    }
+
+    inline bool is_tab_or_newline(char c) { return c == '\t' || c == '\n' || c == '\r'; }
+
+    inline bool ends_authority(char c) { return c == '/' || c == '?' || c == '#'; }
+
+    // WHATWG IPv4 number: decimal, 0x-prefixed hex or 0-prefixed octal
+    bool ipv4_number(const char* first, const char* last, uint64_t& value) {
+        int base = 10;
+        if (last - first >= 2 && first[0] == '0' && (first[1] == 'x' || first[1] == 'X')) {
+            base = 16;
+            first += 2;
+        } else if (last - first >= 2 && first[0] == '0') {
+            base = 8;
+            ++first;
+        }
+        value = 0;
+        for (const char* p = first; p != last; ++p) {
+            int digit;
+            if (*p >= '0' && *p <= '9') digit = *p - '0';
+            else if (base == 16 && *p >= 'a' && *p <= 'f') digit = *p - 'a' + 10;
+            else if (base == 16 && *p >= 'A' && *p <= 'F') digit = *p - 'A' + 10;
+            else return false;
+            if (digit >= base) return false;
+            value = value * static_cast<uint64_t>(base) + static_cast<uint64_t>(digit);
+            if (value > 0xFFFFFFFFull) value = 0x100000000ull;  // Saturate; only the range matters
+        }
+        return true;
+    }
+
+    // A special-scheme host whose last label is numeric must be an IPv4
+    // address in the WHATWG sense (1 to 4 parts, the last filling the rest)
+    bool whatwg_ipv4(const char* first, const char* last) {
+        if (last != first && last[-1] == '.') --last;  // One trailing dot is allowed
+        const char* label = last;
+        while (label != first && label[-1] != '.') --label;
+        uint64_t value;
+        const bool all_digits = std::all_of(label, last, [](char c) { return c >= '0' && c <= '9'; });
+        if (label == last || !(all_digits || ipv4_number(label, last, value))) return true;
+
+        int parts = 0;
+        uint64_t numbers[4];
+        for (const char* p = first;;) {
+            const char* dot = p;
+            while (dot != last && *dot != '.') ++dot;
+            if (parts == 4 || dot == p || !ipv4_number(p, dot, numbers[parts])) return false;
+            ++parts;
+            if (dot == last) break;
+            p = dot + 1;
+        }
+        for (int i = 0; i < parts - 1; ++i) {
+            if (numbers[i] > 255) return false;
+        }
+        return numbers[parts - 1] < (uint64_t{1} << (8 * (5 - parts)));
+    }
+
+    class Checker {
+    public:
+        Checker(std::string_view url, URLError& error) : begin_(url.data()), error_(error) {}
+
+        bool strict(std::string_view url);
+        bool lenient(std::string_view url);
+
+    private:
+        bool fail(URLErrc code, const char* where) {
+            error_.code = code;
+            error_.offset = static_cast<uint32_t>(where - begin_);
+            return false;
+        }
+
+        // scheme ":" ; leaves p after the colon
+        bool scheme(const char*& p, const char* end, SchemeId& id) {
+            // Same order of checks, and so the same codes, as URLImpl::scan
+            const char* first = p;
+            while (p != end && is(*p, kSchemeChar)) ++p;
+            if (p == first || p == end || *p != ':') return fail(URLErrc::invalid_format, p);
+            if (!is(*first, kAlphaChar)) return fail(URLErrc::invalid_scheme, first);
+            id = lookup_scheme(std::string_view(first, static_cast<size_t>(p - first)));
+            ++p;
+            return true;
+        }
+
+        bool port(const char* first, const char* last) {
+            uint32_t value = 0;
+            for (const char* q = first; q != last; ++q) {
+                if (!is(*q, kDigitChar)) return fail(URLErrc::invalid_port, q);
+                value = value * 10 + static_cast<uint32_t>(*q - '0');
+                if (value > 65535) return fail(URLErrc::port_out_of_range, first);
+            }
+            return true;
+        }
+
+        bool strict_authority(const char*& p, const char* end, SchemeId id);
+        bool lenient_authority(const char*& p, const char* end, SchemeId id);
+
+        const char* begin_;
+        URLError& error_;
+    };
+
+    // authority = [ userinfo "@" ] host [ ":" port ] in one pass. Userinfo
+    // is reg-name plus ':', so both run through the same table loop; an
+    // IP literal goes to parse_ipv6 (IPvFuture is refused, as parse()
+    // cannot represent it).
+    bool Checker::strict_authority(const char*& p, const char* end, SchemeId id) {
+        const char* const authority = p;
+        const char* host = p;
+        const char* first_colon = nullptr;
+        const char* last_colon = nullptr;
+
+        for (;;) {
+            p = simd::skip_escaped(p, end, kRegNameClass);
+            if (p == end) break;
+
+            if (*p == '%') {
+                return fail(URLErrc::invalid_percent_encoding, p);
+            } else if (*p == ':') {
+                if (!first_colon) first_colon = p;
+                last_colon = p++;
+            } else if (*p == '@' && host == authority) {
+                host = ++p;
+                first_colon = last_colon = nullptr;
+            } else if (*p == '[' && p == host) {
+                const char* close = p;
+                while (close != end && *close != ']' && !ends_authority(*close)) ++close;
+                if (close == end || *close != ']' || close - p < 2) return fail(URLErrc::invalid_host, host);
+                std::array<uint8_t, 16> address;
+                if (!parse_ipv6(std::string_view(p + 1, static_cast<size_t>(close - p - 1)), address)) {
+                    return fail(URLErrc::invalid_host, host + 1);
+                }
+                p = close + 1;
+                if (p != end && *p != ':' && !ends_authority(*p)) return fail(URLErrc::invalid_host, host);
+            } else {
+                break;
+            }
+        }
+
+        if (p != end && !ends_authority(*p)) {
+            // Blame userinfo if an '@' is still to come
+            const char* q = p;
+            while (host == authority && q != end && !ends_authority(*q) && *q != '@') ++q;
+            const bool in_userinfo = host == authority && q != end && *q == '@';
+            return fail(in_userinfo ? URLErrc::invalid_userinfo : URLErrc::invalid_host, p);
+        }
+
+        // The port colon is the last one; any earlier one sits in the host
+        const char* host_end = last_colon ? last_colon : p;
+        if (first_colon != last_colon) return fail(URLErrc::invalid_host, first_colon);
+        if (host == host_end && id != SchemeId::file) return fail(URLErrc::invalid_authority, host);
+        return !last_colon || port(last_colon + 1, p);
+    }
+
+    // RFC 3986 URI = scheme ":" hier-part [ "?" query ] [ "#" fragment ],
+    // plus the scheme-specific rules URL::parse applies (a host for every
+    // scheme but file, a port below 65536)
+    bool Checker::strict(std::string_view url) {
+        const char* p = url.data();
+        const char* const end = p + url.size();
+        const char* bad = nullptr;
+
+        SchemeId id;
+        if (!scheme(p, end, id)) return false;
+
+        if (end - p >= 2 && p[0] == '/' && p[1] == '/') {
+            p += 2;
+            if (!strict_authority(p, end, id)) return false;
+        }
+
+        // path-abempty, path-absolute, path-rootless and path-empty share
+        // one character set
+        p = skip_component(p, end, kPathClass, bad);
+        if (!p) return fail(URLErrc::invalid_percent_encoding, bad);
+        if (p != end && *p == '?') {
+            p = skip_component(p + 1, end, kQueryClass, bad);
+            if (!p) return fail(URLErrc::invalid_percent_encoding, bad);
+            if (p != end && *p != '#') return fail(URLErrc::invalid_query, p);
+        } else if (p != end && *p != '#') {
+            return fail(URLErrc::invalid_path, p);
+        }
+        if (p != end) {
+            p = skip_component(p + 1, end, kQueryClass, bad);
+            if (!p) return fail(URLErrc::invalid_percent_encoding, bad);
+            if (p != end) return fail(URLErrc::invalid_fragment, p);
+        }
+        return true;
+    }
+
+    // Credentials run to the last '@' and may hold anything, so a bad
+    // host character only counts once no later '@' claims it
+    bool Checker::lenient_authority(const char*& p, const char* end, SchemeId id) {
+        const bool special = scheme_info(id).special;
+        const char* host = p;
+        const char* last_colon = nullptr;
+        const char* bad = nullptr;
+        bool has_credentials = false;
+        bool in_brackets = false;
+
+        for (; p != end; ++p) {
+            while (p != end && is(*p, kDomainChar)) ++p;
+            if (p == end) break;
+
+            const char c = *p;
+            if (ends_authority(c) || (special && c == '\\')) break;
+            if (c == '@') {
+                host = p + 1;
+                last_colon = bad = nullptr;
+                has_credentials = true;
+                in_brackets = false;
+            } else if (c == ':') {
+                if (!in_brackets) last_colon = p;
+            } else if (c == '[' && p == host) {
+                in_brackets = true;
+            } else if (c == ']' && in_brackets) {
+                in_brackets = false;
+            } else if (!bad) {
+                // Opaque hosts percent-encode C0 controls and DEL rather
+                // than rejecting them
+                const auto u = static_cast<unsigned char>(c);
+                const bool control = (u < 0x20 || u == 0x7F) && u != 0 && !is_tab_or_newline(c);
+                if (special || !control) bad = p;
+            }
+        }
+
+        const char* host_end = last_colon ? last_colon : p;
+        if (bad && bad < host_end) return fail(URLErrc::invalid_host, bad);
+        if (host == host_end) {
+            if (has_credentials) return fail(URLErrc::invalid_host, host);
+            if (special && id != SchemeId::file) return fail(URLErrc::invalid_authority, host);
+        } else if (*host == '[') {
+            std::array<uint8_t, 16> address;
+            if (host_end - host < 3 || host_end[-1] != ']') return fail(URLErrc::invalid_host, host);
+            const std::string_view literal(host + 1, static_cast<size_t>(host_end - host - 2));
+            if (!parse_ipv6(literal, address)) return fail(URLErrc::invalid_host, host + 1);
+        } else if (special && !whatwg_ipv4(host, host_end)) {
+            return fail(URLErrc::invalid_host, host);
+        }
+
+        if (!last_colon) return true;
+        for (const char* q = last_colon + 1; q != p; ++q) {
+            if (is_tab_or_newline(*q)) return fail(URLErrc::invalid_port, q);
+        }
+        return port(last_colon + 1, p);
+    }
+
+    // Fails exactly where the WHATWG basic URL parser (without a base)
+    // returns failure; its non-fatal "validation errors" are accepted.
+    // Tabs and newlines, which the parser strips, are only tolerated
+    // where they cannot change the outcome: in paths, queries and
+    // fragments (anywhere else they count as invalid).
+    bool Checker::lenient(std::string_view url) {
+        const char* p = url.data();
+        const char* end = p + url.size();
+        while (p != end && static_cast<unsigned char>(*p) <= 0x20) ++p;
+        while (end != p && static_cast<unsigned char>(end[-1]) <= 0x20) --end;
+
+        SchemeId id;
+        if (!scheme(p, end, id)) return false;
+
+        const bool special = scheme_info(id).special;
+        auto is_slash = [special](char c) { return c == '/' || (special && c == '\\'); };
+
+        if (special && id != SchemeId::file) {
+            // Special schemes skip any run of slashes before the authority
+            while (p != end && is_slash(*p)) ++p;
+        } else if (end - p >= 2 && is_slash(p[0]) && is_slash(p[1])) {
+            p += 2;
+        } else {
+            return true;  // No authority; the rest is path and cannot fail
+        }
+        return lenient_authority(p, end, id);
+    }
+}
+
+URLError URL::check(std::string_view url, ValidationProfile profile) noexcept {
+    if (url.size() > UINT32_MAX) {
+        return URLError{URLErrc::too_long, UINT32_MAX};
+    }
+    URLError error;
+    Checker checker(url, error);
+    if (profile == ValidationProfile::whatwg) {
+        checker.lenient(url);
+    } else {
+        checker.strict(url);
+    }
+    return error;
+}
+
+} // namespace seedlib
@@ -0,0 +1,112 @@
+// src/work_stealing.hpp (private header)
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace seedlib {
+
+// Runs fn(chunk) for every chunk in [0, chunk_count) on up to `threads`
+// threads (the caller included). Each worker starts with an equal slice of
+// chunk indices and takes from its front; a worker that runs dry steals
+// the back half of the fullest remaining slice, so a slice full of slow
+// chunks does not leave the other workers idle.
+class WorkStealingRanges {
+public:
+    template <typename F>
+    static void run(size_t chunk_count, unsigned threads, F&& fn) {
+        threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, chunk_count)));
+        if (threads <= 1) {
+            for (size_t chunk = 0; chunk < chunk_count; ++chunk) fn(chunk);
+            return;
+        }
+
+        std::vector<Slot> slots(threads);
+        for (unsigned t = 0; t < threads; ++t) {
+            slots[t].range.store(pack(static_cast<uint32_t>(chunk_count * t / threads),
+                                      static_cast<uint32_t>(chunk_count * (t + 1) / threads)),
+                                 std::memory_order_relaxed);
+        }
+
+        auto worker = [&slots, &fn](unsigned self) {
+            for (;;) {
+                uint32_t chunk;
+                if (pop_front(slots[self].range, chunk)) {
+                    fn(static_cast<size_t>(chunk));
+                } else if (!steal(slots, self)) {
+                    return;
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; ++t) {
+            pool.emplace_back(worker, t);
+        }
+        worker(0);
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+
+private:
+    // [begin, end) of chunk indices packed into one word so owner pops and
+    // thief splits are a single compare-and-swap
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> range{0};
+    };
+
+    static uint64_t pack(uint32_t begin, uint32_t end) {
+        return (uint64_t{end} << 32) | begin;
+    }
+    static uint32_t begin_of(uint64_t range) { return static_cast<uint32_t>(range); }
+    static uint32_t end_of(uint64_t range) { return static_cast<uint32_t>(range >> 32); }
+
+    static bool pop_front(std::atomic<uint64_t>& range, uint32_t& chunk) {
+        uint64_t current = range.load(std::memory_order_acquire);
+        while (begin_of(current) < end_of(current)) {
+            if (range.compare_exchange_weak(current, pack(begin_of(current) + 1, end_of(current)),
+                                            std::memory_order_acq_rel)) {
+                chunk = begin_of(current);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Moves the back half of the fullest victim slice into self's (empty)
+    // slice; returns false once every slice is empty
+    static bool steal(std::vector<Slot>& slots, unsigned self) {
+        for (;;) {
+            unsigned victim = self;
+            uint32_t most = 0;
+            for (unsigned t = 0; t < slots.size(); ++t) {
+                uint64_t range = slots[t].range.load(std::memory_order_acquire);
+                uint32_t remaining = end_of(range) - std::min(begin_of(range), end_of(range));
+                if (t != self && remaining > most) {
+                    most = remaining;
+                    victim = t;
+                }
+            }
+            if (victim == self) return false;
+
+            uint64_t current = slots[victim].range.load(std::memory_order_acquire);
+            uint32_t begin = begin_of(current);
+            uint32_t end = end_of(current);
+            if (begin >= end) continue;
+
+            uint32_t split = end - (end - begin + 1) / 2;
+            if (slots[victim].range.compare_exchange_strong(current, pack(begin, split),
+                                                            std::memory_order_acq_rel)) {
+                slots[self].range.store(pack(split, end), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+};
+
+} // namespace seedlib
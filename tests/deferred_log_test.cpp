@@ -0,0 +1,169 @@
+// tests/deferred_log_test.cpp
+// Keeps every level compiled in, whatever the build type
+#define SEEDLIB_ACTIVE_LEVEL 0
+#include <catch2/catch_test_macros.hpp>
+#include <seedlib/deferred_log.hpp>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/ringbuffer_sink.h>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace seedlib;
+
+namespace {
+    std::shared_ptr<spdlog::logger> ring_logger(std::shared_ptr<spdlog::sinks::ringbuffer_sink_mt>& sink) {
+        sink = std::make_shared<spdlog::sinks::ringbuffer_sink_mt>(64);
+        sink->set_pattern("%l %v");
+        auto logger = std::make_shared<spdlog::logger>("deferred_test", sink);
+        logger->set_level(spdlog::level::trace);
+        return logger;
+    }
+
+    std::vector<std::string> lines(spdlog::sinks::ringbuffer_sink_mt& sink) {
+        auto result = sink.last_formatted();
+        for (auto& line : result) {
+            while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.pop_back();
+        }
+        return result;
+    }
+
+    class CountingSink : public spdlog::sinks::base_sink<std::mutex> {
+    public:
+        std::atomic<size_t> count{0};
+
+    protected:
+        void sink_it_(const spdlog::details::log_msg&) override { ++count; }
+        void flush_() override {}
+    };
+
+    enum class Color : uint8_t { red = 2 };
+
+    template <typename Format, typename = void>
+    struct loggable : std::false_type {};
+    template <typename Format>
+    struct loggable<Format, std::void_t<decltype(DeferredLog::instance().log(spdlog::level::info,
+                                                                             std::declval<Format>(), 1))>>
+        : std::true_type {};
+}
+
+TEST_CASE("Deferred format strings must be literals", "[logging][deferred]") {
+    // The ring keeps only the pointer, so temporaries would dangle
+    STATIC_REQUIRE(loggable<const char (&)[3]>::value);
+    STATIC_REQUIRE_FALSE(loggable<const char*>::value);
+    STATIC_REQUIRE_FALSE(loggable<std::string>::value);
+    STATIC_REQUIRE_FALSE(loggable<decltype(fmt::runtime(""))>::value);
+}
+
+TEST_CASE("Deferred records are formatted off the calling thread", "[logging][deferred]") {
+    std::shared_ptr<spdlog::sinks::ringbuffer_sink_mt> sink;
+    DeferredLogOptions options;
+    options.logger = ring_logger(sink);
+    options.level = spdlog::level::debug;
+    DeferredLog& log = DeferredLog::instance();
+    log.start(options);
+
+    SECTION("Arguments of every supported kind") {
+        const std::string owned = "owned";
+        const char* text = "text";
+        int value = -7;
+        log.log(spdlog::level::info, "{} {} {} {} {} {:.2f} {} {} {}", true, 'c', value, 42u, 1.5f, 2.25, owned,
+                text, std::string_view("view"));
+        log.log(spdlog::level::warn, "color={} hex={:#x}", static_cast<int>(Color::red), 255);
+        log.log(spdlog::level::trace, "below the level");
+        log.flush();
+
+        const auto out = lines(*sink);
+        REQUIRE(out.size() == 2);
+        CHECK(out[0] == "info true c -7 42 1.5 2.25 owned text view");
+        CHECK(out[1] == "warning color=2 hex=0xff");
+    }
+
+    SECTION("Strings are copied at the call") {
+        std::string changing = "before";
+        LOG_DEFERRED_INFO("value={}", changing);
+        changing = "after";
+        log.flush();
+        CHECK(lines(*sink).back() == "info value=before");
+    }
+
+    SECTION("Records from many threads all arrive") {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([t] {
+                for (int i = 0; i < 8; ++i) LOG_DEFERRED_WARN("thread {} record {}", t, i);
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        log.flush();
+        CHECK(lines(*sink).size() == 32);
+    }
+
+    log.stop();
+    CHECK_FALSE(log.running());
+}
+
+TEST_CASE("Full rings drop and count instead of blocking", "[logging][deferred]") {
+    auto counting = std::make_shared<CountingSink>();
+    DeferredLogOptions options;
+    options.logger = std::make_shared<spdlog::logger>("deferred_count", counting);
+    options.level = spdlog::level::info;
+    options.ring_bytes = 4096;  // Room for about a hundred records
+    DeferredLog& log = DeferredLog::instance();
+    log.start(options);
+    const uint64_t dropped_before = log.dropped();
+
+    constexpr int kRecords = 20000;
+    std::thread producer([] {
+        for (int i = 0; i < kRecords; ++i) LOG_DEFERRED_WARN("record {}", i);
+    });
+    producer.join();
+    log.flush();
+    log.stop();
+
+    CHECK(counting->count + (log.dropped() - dropped_before) == kRecords);
+}
+
+TEST_CASE("Binary deferred logs decode offline", "[logging][deferred]") {
+    const std::string path = "deferred_log_test.bin";
+    DeferredLogOptions options;
+    options.binary_path = path;
+    options.level = spdlog::level::info;
+    DeferredLog& log = DeferredLog::instance();
+    log.start(options);
+
+    for (int i = 0; i < 3; ++i) {
+        LOG_DEFERRED_WARN("request {} took {}us on {}", i, 12.5 * i, "worker");
+    }
+    LOG_DEFERRED_ERROR("done");
+    log.stop();
+
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream out;
+    REQUIRE(decode_deferred_log(in, out));
+    std::remove(path.c_str());
+
+    std::istringstream decoded(out.str());
+    std::vector<std::string> messages;
+    for (std::string line; std::getline(decoded, line);) {
+        // "[<UTC time>] [<level>] <message>"
+        const size_t level_end = line.find("] ", line.find("] [") + 3);
+        REQUIRE(level_end != std::string::npos);
+        messages.push_back(line.substr(line.find("] [") + 2));
+    }
+    REQUIRE(messages.size() == 4);
+    CHECK(messages[0] == "[warning] request 0 took 0us on worker");
+    CHECK(messages[2] == "[warning] request 2 took 25us on worker");
+    CHECK(messages[3] == "[error] done");
+
+    std::istringstream truncated(std::string("SEEDLOG1R\x01", 10));
+    std::ostringstream ignored;
+    CHECK_FALSE(decode_deferred_log(truncated, ignored));
+}
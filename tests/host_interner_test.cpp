@@ -0,0 +1,107 @@
+// tests/host_interner_test.cpp
+#include <catch2/catch_test_macros.hpp>
+#include <seedlib/host_interner.hpp>
+#include <seedlib/url.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace seedlib;
+
+TEST_CASE("Host interning", "[interner]") {
+    HostInterner interner;
+
+    SECTION("Equal text shares one copy") {
+        std::string a = "example.com";
+        std::string b = "example.com";
+        const auto first = interner.intern(a);
+        const auto second = interner.intern(b);
+        CHECK(first == "example.com");
+        CHECK(first.data() == second.data());
+        CHECK(first.data() != a.data());
+        CHECK(interner.intern("example.org").data() != first.data());
+        CHECK(interner.size() == 2);
+    }
+
+    SECTION("find never inserts") {
+        CHECK(interner.find("missing.example").data() == nullptr);
+        const auto interned = interner.intern("present.example");
+        CHECK(interner.find("present.example").data() == interned.data());
+        CHECK(interner.size() == 1);
+    }
+
+    SECTION("Views stay valid as tables grow") {
+        std::vector<std::string_view> views;
+        for (int i = 0; i < 5000; ++i) {
+            views.push_back(interner.intern("host" + std::to_string(i) + ".example"));
+        }
+        CHECK(interner.size() == 5000);
+        for (int i = 0; i < 5000; ++i) {
+            const std::string text = "host" + std::to_string(i) + ".example";
+            REQUIRE(views[i] == text);
+            CHECK(interner.find(text).data() == views[i].data());
+        }
+        CHECK(interner.bytes_reserved() > 0);
+    }
+
+    SECTION("Concurrent interning agrees on one copy") {
+        constexpr int kThreads = 4;
+        constexpr int kHosts = 2000;
+        std::vector<std::vector<const char*>> seen(kThreads, std::vector<const char*>(kHosts));
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < kHosts; ++i) {
+                    const int host = (i * (t + 1)) % kHosts;
+                    seen[t][host] = interner.intern("h" + std::to_string(host)).data();
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        CHECK(interner.size() == kHosts);
+        for (int t = 1; t < kThreads; ++t) {
+            for (int i = 0; i < kHosts; ++i) {
+                if (seen[t][i] && seen[0][i]) REQUIRE(seen[t][i] == seen[0][i]);
+            }
+        }
+    }
+}
+
+TEST_CASE("URLs with interned hosts", "[interner][url]") {
+    HostInterner interner;
+    auto a = URL::parse("https://example.com/a?x=1", interner).value();
+    auto b = URL::parse("https://example.com:8443/b", interner).value();
+
+    SECTION("Hosts share storage and serialize normally") {
+        CHECK(a.host().data() == b.host().data());
+        CHECK(a.to_string() == "https://example.com/a?x=1");
+        CHECK(b.to_string() == "https://example.com:8443/b");
+
+        std::string out;
+        b.append_to(out);
+        CHECK(out == b.to_string());
+
+        auto copy = a;
+        CHECK(copy.host().data() == a.host().data());
+    }
+
+    SECTION("Setters detach from the pool") {
+        a.set_path("/new");
+        CHECK(a.host().data() == b.host().data());
+        a.set_host("other.example");
+        CHECK(a.host() == "other.example");
+        CHECK(a.to_string() == "https://other.example/new?x=1");
+        CHECK(b.host() == "example.com");
+    }
+
+    SECTION("Normalization keeps canonical interned hosts") {
+        a.normalize();
+        CHECK(a.host().data() == b.host().data());
+
+        auto mixed = URL::parse("http://Example.COM/", interner).value();
+        mixed.normalize();
+        CHECK(mixed.host() == "example.com");
+        CHECK(interner.find("Example.COM") == "Example.COM");
+    }
+}
@@ -0,0 +1,95 @@
+// tests/host_test.cpp
+#include <catch2/catch_test_macros.hpp>
+#include <seedlib/host.hpp>
+#include <seedlib/url.hpp>
+
+using namespace seedlib;
+
+TEST_CASE("IPv4 literals", "[host]") {
+    std::array<uint8_t, 4> out{};
+
+    SECTION("Dotted quads decode to network order") {
+        REQUIRE(parse_ipv4("192.168.0.1", out));
+        CHECK(out == std::array<uint8_t, 4>{192, 168, 0, 1});
+        REQUIRE(parse_ipv4("255.255.255.255", out));
+        CHECK(out == std::array<uint8_t, 4>{255, 255, 255, 255});
+        REQUIRE(parse_ipv4("0.0.0.0", out));
+    }
+
+    SECTION("Anything else is rejected") {
+        for (auto text : {"256.1.1.1", "1.2.3", "1.2.3.4.5", "01.2.3.4", "1.2.3.4.", "1..3.4",
+                          "1.2.3.1000", "a.b.c.d", "1.2.3.-4", ""}) {
+            INFO(text);
+            CHECK_FALSE(parse_ipv4(text, out));
+        }
+    }
+}
+
+TEST_CASE("IPv6 literals", "[host]") {
+    std::array<uint8_t, 16> out{};
+    auto bytes = [](std::initializer_list<int> values) {
+        std::array<uint8_t, 16> result{};
+        size_t i = 0;
+        for (int v : values) result[i++] = static_cast<uint8_t>(v);
+        return result;
+    };
+
+    SECTION("RFC 4291 text forms") {
+        REQUIRE(parse_ipv6("2001:db8:0:0:8:800:200c:417a", out));
+        CHECK(out == bytes({0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 8, 8, 0, 0x20, 0x0c, 0x41, 0x7a}));
+        REQUIRE(parse_ipv6("2001:DB8::8:800:200C:417A", out));
+        CHECK(out == bytes({0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 8, 8, 0, 0x20, 0x0c, 0x41, 0x7a}));
+        REQUIRE(parse_ipv6("::1", out));
+        CHECK(out == bytes({0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1}));
+        REQUIRE(parse_ipv6("::", out));
+        CHECK(out == bytes({}));
+        REQUIRE(parse_ipv6("fe80::", out));
+        CHECK(out == bytes({0xfe, 0x80}));
+        REQUIRE(parse_ipv6("::ffff:192.0.2.128", out));
+        CHECK(out == bytes({0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 192, 0, 2, 128}));
+    }
+
+    SECTION("Malformed literals are rejected") {
+        for (auto text : {"", ":", ":::", "1::2::3", "1:2:3:4:5:6:7", "1:2:3:4:5:6:7:8:9", "12345::",
+                          "1:", ":1", "::g", "1:2:3:4:5:6:7:1.2.3.4", "::1.2.3", "fe80::1%25eth0"}) {
+            INFO(text);
+            CHECK_FALSE(parse_ipv6(text, out));
+        }
+    }
+}
+
+TEST_CASE("URL host classification", "[host][url]") {
+    SECTION("Kinds are recorded by the parser") {
+        CHECK(URL::parse("http://example.com").value().host_kind() == HostKind::domain);
+        CHECK(URL::parse("http://256.1.1.1").value().host_kind() == HostKind::domain);
+        CHECK(URL::parse("file:///etc/hosts").value().host_kind() == HostKind::none);
+
+        auto v4 = URL::parse("http://10.0.0.7:8080/").value();
+        CHECK(v4.host_kind() == HostKind::ipv4);
+        REQUIRE(v4.ip_address().has_value());
+        CHECK(v4.ip_address()->size() == 4);
+        CHECK(v4.ip_address()->bytes[3] == 7);
+
+        auto v6 = URLView::parse("http://[2001:db8::1]/").value();
+        CHECK(v6.host_kind() == HostKind::ipv6);
+        CHECK(v6.ip_address()->bytes[15] == 1);
+        CHECK_FALSE(URL::parse("http://example.com").value().ip_address().has_value());
+    }
+
+    SECTION("Malformed IPv6 literals are invalid hosts") {
+        URLError error;
+        CHECK_FALSE(URL::try_parse("http://[1::2::3]/", error).has_value());
+        CHECK(error.code == URLErrc::invalid_host);
+        CHECK(error.offset == 8);
+    }
+
+    SECTION("set_host reclassifies") {
+        auto url = URL::parse("http://example.com/").value();
+        url.set_host("[::1]");
+        CHECK(url.host_kind() == HostKind::ipv6);
+        url.set_host("127.0.0.1");
+        CHECK(url.ip_address()->bytes[0] == 127);
+        url.set_host("localhost");
+        CHECK(url.host_kind() == HostKind::domain);
+    }
+}
@@ -0,0 +1,143 @@
+// tests/logging_test.cpp
+// Caps this translation unit at warn, as a release build would be
+#define SEEDLIB_ACTIVE_LEVEL 3
+// and keeps LOG_METRIC on the log route; metrics_test covers the registry
+#define SEEDLIB_METRICS_ROUTE 0
+#include <catch2/catch_test_macros.hpp>
+#include <seedlib/logging.hpp>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/ringbuffer_sink.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+
+using namespace seedlib;
+
+namespace {
+    int evaluated = 0;
+
+    int touch() {
+        return ++evaluated;
+    }
+
+    // Routes the singleton to a ring buffer of bare messages
+    std::shared_ptr<spdlog::sinks::ringbuffer_sink_mt> capture() {
+        auto sink = std::make_shared<spdlog::sinks::ringbuffer_sink_mt>(16);
+        sink->set_pattern("%v");
+        auto logger = std::make_shared<spdlog::logger>("logging_test", sink);
+        logger->set_level(spdlog::level::trace);
+        Logger::instance().init(logger);
+        return sink;
+    }
+
+    std::string last_line(spdlog::sinks::ringbuffer_sink_mt& sink) {
+        auto lines = sink.last_formatted(1);
+        if (lines.empty()) return {};
+        auto line = lines.back();
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) line.pop_back();
+        return line;
+    }
+
+    // Stands in for a disk that has stalled
+    class SlowSink : public spdlog::sinks::base_sink<std::mutex> {
+    protected:
+        void sink_it_(const spdlog::details::log_msg&) override {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        void flush_() override {}
+    };
+}
+
+TEST_CASE("Disabled log levels compile to nothing", "[logging]") {
+    // Elided levels are plain void expressions, not calls
+    STATIC_REQUIRE(std::is_void_v<decltype(LOG_DEBUG("{}", touch()))>);
+    STATIC_REQUIRE(std::is_void_v<decltype(LOG_INFO("{}", touch()))>);
+
+    evaluated = 0;
+    LOG_DEBUG("{}", touch());
+    LOG_INFO("{}", touch());
+    CHECK(evaluated == 0);
+}
+
+TEST_CASE("Enabled log levels check the runtime level first", "[logging]") {
+    auto sink = capture();
+
+    evaluated = 0;
+    Logger::instance().set_level(spdlog::level::off);
+    LOG_WARN("{}", touch());
+    LOG_ERROR("{}", touch());
+    LOG_METRIC("requests", static_cast<double>(touch()));
+    CHECK(evaluated == 0);
+
+    Logger::instance().set_level(spdlog::level::warn);
+    LOG_WARN("value {}", touch());
+    LOG_METRIC("requests", static_cast<double>(touch()));
+    CHECK(evaluated == 1);
+    CHECK(last_line(*sink) == "value 1");
+}
+
+TEST_CASE("Structured fields and metric tags", "[logging]") {
+    auto sink = capture();
+    Logger& logger = Logger::instance();
+
+    SECTION("Pairs keep their order") {
+        logger.metric("latency_ms", 4.5, {{"endpoint", "/a"}, {"method", "GET"}});
+        CHECK(last_line(*sink) == "METRIC latency_ms value=4.5 endpoint=/a,method=GET");
+
+        logger.metric("latency_ms", 4.5);
+        CHECK(last_line(*sink) == "METRIC latency_ms value=4.5 ");
+
+        logger.info("user_login", {{"user_id", "42"}}, "User {} logged in", 42);
+        CHECK(last_line(*sink) == "event=user_login user_id=42  User 42 logged in");
+    }
+
+    SECTION("Variadic tags format their values in place") {
+        logger.metric("responses", 1, "status", 200, "endpoint", std::string("/b"));
+        CHECK(last_line(*sink) == "METRIC responses value=1 status=200,endpoint=/b");
+    }
+
+    SECTION("Map tags produce the same line") {
+        const std::unordered_map<std::string, std::string> tags{{"cache", "url"}};
+        logger.metric("hits", 2, tags);
+        CHECK(last_line(*sink) == "METRIC hits value=2 cache=url");
+    }
+}
+
+TEST_CASE("Logging options default to the configured values", "[logging]") {
+    STATIC_REQUIRE(detail::parse_log_size("10MB") == 10u << 20);
+    STATIC_REQUIRE(detail::parse_log_size("512KB") == 512u << 10);
+    STATIC_REQUIRE(detail::parse_log_size("4096") == 4096);
+
+    const LoggingOptions options;
+    CHECK(options.queue_size == LOG_QUEUE_SIZE);
+    CHECK(options.worker_threads == LOG_THREAD_COUNT);
+    CHECK(options.flush_interval.count() == LOG_FLUSH_INTERVAL_MS);
+    CHECK(options.file_path == LOG_FILE_PATH);
+    CHECK(options.max_file_size == detail::parse_log_size(LOG_MAX_SIZE));
+    CHECK(options.max_files == LOG_MAX_FILES);
+    CHECK(options.overflow == spdlog::async_overflow_policy::overrun_oldest);
+    CHECK(options.extra_sinks.empty());
+}
+
+TEST_CASE("A full async queue drops instead of blocking", "[logging]") {
+    LoggingOptions options;
+    options.app_name = "logging_test_async";
+    options.console = false;
+    options.file = false;
+    options.async = true;
+    options.queue_size = 8;
+    options.worker_threads = 1;
+    // Given up front: the worker reads the sink list as soon as init returns
+    options.extra_sinks.push_back(std::make_shared<SlowSink>());
+    Logger& logger = Logger::instance();
+    logger.init(options);
+
+    // At 2ms a message the worker drains a few while 200 are queued, so
+    // nearly all of them overrun the 8 slots
+    for (int i = 0; i < 200; ++i) LOG_WARN("burst {}", i);
+
+    CHECK(logger.dropped() > 0);
+}
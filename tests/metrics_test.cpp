@@ -0,0 +1,144 @@
+// tests/metrics_test.cpp
+// LOG_METRIC takes the registry route here, whatever LOG_METRICS_TO_REGISTRY says
+#define SEEDLIB_METRICS_ROUTE 1
+#include <catch2/catch_test_macros.hpp>
+#include <seedlib/logging.hpp>
+#include <seedlib/metrics.hpp>
+#include <seedlib/url.hpp>
+#include <spdlog/sinks/ringbuffer_sink.h>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace seedlib;
+
+namespace {
+    bool contains(const std::string& text, const std::string& part) {
+        return text.find(part) != std::string::npos;
+    }
+}
+
+TEST_CASE("Histogram buckets stay within a sixteenth of their values", "[metrics]") {
+    using metrics::detail::bucket_index;
+    using metrics::detail::bucket_upper;
+    STATIC_REQUIRE(bucket_index(15) == 15);
+    STATIC_REQUIRE(bucket_upper(bucket_index(16)) == 16);
+    STATIC_REQUIRE(bucket_index(uint64_t{1} << 60) == metrics::detail::kBuckets - 1);
+
+    for (uint64_t value : {1ull, 17ull, 100ull, 1000ull, 123456ull, 987654321ull, 1ull << 47}) {
+        const uint64_t upper = bucket_upper(bucket_index(value));
+        CHECK(upper >= value);
+        CHECK(upper - value <= value / 16);
+    }
+}
+
+TEST_CASE("Counters sum every thread's cells", "[metrics]") {
+    const metrics::Counter requests = metrics::counter("test_requests_total", {{"route", "a"}});
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&requests] {
+            for (int i = 0; i < 1000; ++i) requests.add();
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    // The exited threads' blocks still count
+    CHECK(requests.value() == 4000);
+
+    requests.add(5);
+    CHECK(metrics::counter("test_requests_total", {{"route", "a"}}).value() == 4005);
+    CHECK(metrics::counter("test_requests_total", {{"route", "b"}}).value() == 0);
+    CHECK_THROWS_AS(metrics::gauge("test_requests_total"), std::invalid_argument);
+}
+
+TEST_CASE("Gauges keep the last level", "[metrics]") {
+    const metrics::Gauge depth = metrics::gauge("test_queue_depth");
+    depth.set(10);
+    depth.add(-2.5);
+    CHECK(depth.value() == 7.5);
+}
+
+TEST_CASE("Histograms report quantiles", "[metrics]") {
+    const metrics::Histogram latency = metrics::histogram("test_latency_ns");
+    for (uint64_t i = 1; i <= 1000; ++i) latency.record(i);
+
+    const metrics::HistogramSnapshot snapshot = latency.snapshot();
+    CHECK(snapshot.count == 1000);
+    CHECK(snapshot.sum == 500500);
+    CHECK(snapshot.max == 1000);
+    CHECK(snapshot.percentile(0.5) >= 500);
+    CHECK(snapshot.percentile(0.5) <= 500 + 500 / 16);
+    CHECK(snapshot.percentile(1.0) == 1000);
+
+    const std::string line = metrics::summary();
+    CHECK(contains(line, "test_latency_ns{count=1000,mean=500.5,p50="));
+    CHECK(contains(line, ",max=1000}"));
+}
+
+TEST_CASE("Prometheus text and LOG_METRIC-style recording", "[metrics]") {
+    metrics::record("test.request_ms", 4.5, {{"method", "GET"}});
+    metrics::record("test.request_ms", 1.25, "method", "GET");
+    metrics::counter("test_hits_total").add(3);
+
+    const std::string text = metrics::prometheus();
+    CHECK(contains(text, "# TYPE test_hits_total counter\ntest_hits_total 3\n"));
+    CHECK(contains(text, "# TYPE test_request_ms summary\n"));
+    CHECK(contains(text, "test_request_ms{method=\"GET\",quantile=\"0.99\"} 4.5\n"));
+    CHECK(contains(text, "test_request_ms_sum{method=\"GET\"} 5.75\n"));
+    CHECK(contains(text, "test_request_ms_count{method=\"GET\"} 2\n"));
+}
+
+TEST_CASE("LOG_METRIC records into histograms on the registry route", "[metrics][logging]") {
+    auto sink = std::make_shared<spdlog::sinks::ringbuffer_sink_mt>(8);
+    sink->set_pattern("%v");
+    auto logger = std::make_shared<spdlog::logger>("metrics_route_test", sink);
+    logger->set_level(spdlog::level::off);
+    Logger::instance().init(logger);
+
+    // Recorded regardless of the log level, and never written to the log
+    LOG_METRIC("test.routed_ms", 2.5, "method", "GET");
+    LOG_METRIC("test.routed_ms", 7.25, {{"method", "GET"}});
+    const metrics::HistogramSnapshot snapshot =
+        metrics::histogram("test.routed_ms", {{"method", "GET"}}, 1000.0).snapshot();
+    CHECK(snapshot.count == 2);
+    CHECK(snapshot.sum == 9750);
+    CHECK(sink->last_formatted().empty());
+}
+
+TEST_CASE("The parser counts inputs, bytes and failures", "[metrics][url]") {
+    const metrics::Counter parses = metrics::counter("url_parse_total");
+    const metrics::Counter bytes = metrics::counter("url_parse_bytes_total");
+    const metrics::Counter bad_ports = metrics::counter("url_parse_errors_total", {{"code", "invalid_port"}});
+    const uint64_t parses_before = parses.value();
+    const uint64_t bytes_before = bytes.value();
+    const uint64_t bad_ports_before = bad_ports.value();
+
+    CHECK(URL::parse("http://example.com/"));
+    CHECK_FALSE(URL::parse("http://example.com:12ab/"));
+
+    CHECK(parses.value() - parses_before == 2);
+    CHECK(bytes.value() - bytes_before == 19 + 24);
+    CHECK(bad_ports.value() - bad_ports_before == 1);
+}
+
+TEST_CASE("The reporter logs one summary line per interval", "[metrics]") {
+    auto sink = std::make_shared<spdlog::sinks::ringbuffer_sink_mt>(8);
+    sink->set_pattern("%v");
+    auto logger = std::make_shared<spdlog::logger>("metrics_test", sink);
+    logger->set_level(spdlog::level::info);
+    Logger::instance().init(logger);
+    metrics::counter("test_reported_total").add();
+
+    metrics::start_reporting(std::chrono::milliseconds(5));
+    for (int i = 0; i < 200 && sink->last_formatted().empty(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    metrics::stop_reporting();
+
+    const auto lines = sink->last_formatted();
+    REQUIRE_FALSE(lines.empty());
+    CHECK(lines.front().rfind("METRICS ", 0) == 0);
+    CHECK(contains(lines.front(), " test_reported_total=1"));
+}
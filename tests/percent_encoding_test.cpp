@@ -0,0 +1,70 @@
+// tests/percent_encoding_test.cpp
+#include <catch2/catch_test_macros.hpp>
+#include <seedlib/percent_encoding.hpp>
+
+using namespace seedlib;
+
+TEST_CASE("Percent decoding into a caller buffer", "[percent]") {
+    char out[64];
+
+    SECTION("Escapes and plus signs are decoded") {
+        auto result = percent_decode("a%20b+c%2Fd%c3%a9", out);
+        REQUIRE(result.ok);
+        CHECK(std::string_view(out, result.size) == "a b c/d\xc3\xa9");
+    }
+
+    SECTION("Component mode keeps plus signs") {
+        auto result = percent_decode("a+b%2B", out, PercentDecodeMode::component);
+        REQUIRE(result.ok);
+        CHECK(std::string_view(out, result.size) == "a+b+");
+    }
+
+    SECTION("Malformed escapes are reported") {
+        auto result = percent_decode("abc%2", out);
+        CHECK_FALSE(result.ok);
+        CHECK(result.error_offset == 3);
+        CHECK(std::string_view(out, result.size) == "abc");
+
+        CHECK_FALSE(percent_decode("%zz", out).ok);
+    }
+
+    SECTION("Long literal runs are copied unchanged") {
+        std::string input(200, 'x');
+        input += "%41";
+        std::string buffer(input.size(), '\0');
+        auto result = percent_decode(input, buffer.data());
+        REQUIRE(result.ok);
+        CHECK(buffer.substr(0, result.size) == std::string(200, 'x') + "A");
+    }
+}
+
+TEST_CASE("Percent decoding in place", "[percent]") {
+    SECTION("Strings shrink to the decoded size") {
+        std::string text = "key%3Dvalue";
+        REQUIRE(percent_decode_in_place(text).ok);
+        CHECK(text == "key=value");
+    }
+
+    SECTION("Failure leaves the string unchanged") {
+        std::string text = "a+b%4";
+        CHECK_FALSE(percent_decode_in_place(text).ok);
+        CHECK(text == "a+b%4");
+    }
+
+    SECTION("Lenient decoding keeps only the malformed escapes") {
+        std::string text = "a+b%2";
+        percent_decode_lenient(text);
+        CHECK(text == "a b%2");
+
+        text = "%zz+%41%";
+        percent_decode_lenient(text);
+        CHECK(text == "%zz A%");
+    }
+
+    SECTION("needs_percent_decode detects work") {
+        CHECK_FALSE(needs_percent_decode("plain-text"));
+        CHECK(needs_percent_decode("a+b"));
+        CHECK_FALSE(needs_percent_decode("a+b", PercentDecodeMode::component));
+        CHECK(needs_percent_decode("%41", PercentDecodeMode::component));
+    }
+}
@@ -0,0 +1,79 @@
+// tests/tracing_test.cpp
+// Span sites in this translation unit are compiled in regardless of the
+// library's own setting
+#define SEEDLIB_ENABLE_TRACING 1
+#include <catch2/catch_test_macros.hpp>
+#include <seedlib/tracing.hpp>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace seedlib;
+
+namespace {
+    void traced_work(int spin) {
+        SEEDLIB_TRACE_SPAN("test.work");
+        volatile int sink = 0;
+        for (int i = 0; i < spin; ++i) sink = sink + i;
+    }
+
+    void traced_sleep() {
+        SEEDLIB_TRACE_SPAN("test.sleep");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    size_t count_of(const std::string& text, const std::string& part) {
+        size_t count = 0;
+        for (size_t at = text.find(part); at != std::string::npos; at = text.find(part, at + 1)) ++count;
+        return count;
+    }
+}
+
+TEST_CASE("Spans record their duration in the span histogram", "[tracing]") {
+    const metrics::Histogram sleeps = metrics::histogram("seedlib_span_ns", {{"span", "test.sleep"}});
+    const uint64_t before = sleeps.snapshot().count;
+
+    traced_sleep();
+
+    const metrics::HistogramSnapshot snapshot = sleeps.snapshot();
+    CHECK(snapshot.count == before + 1);
+    // Two milliseconds, give or take the clock calibration and the scheduler
+    CHECK(snapshot.max >= 1500000);
+    CHECK(snapshot.max < 1000000000);
+}
+
+TEST_CASE("Span sites can be created in noexcept functions", "[tracing]") {
+    // A registry failure leaves the site on the detached histogram
+    STATIC_REQUIRE(std::is_nothrow_constructible_v<tracing::SpanSite, const char*>);
+}
+
+TEST_CASE("Captured spans export as Chrome trace events", "[tracing]") {
+    tracing::start_capture();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 4; ++i) traced_work(100);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    tracing::stop_capture();
+    traced_work(100);  // After the capture, so not exported
+
+    std::ostringstream out;
+    CHECK(tracing::write_chrome_trace(out) == 12);
+    const std::string json = out.str();
+    CHECK(json.rfind("{\"traceEvents\":[{\"name\":\"test.work\",\"cat\":\"seedlib\",\"ph\":\"X\",\"ts\":", 0) == 0);
+    CHECK(count_of(json, "\"name\":\"test.work\"") == 12);
+    CHECK(json.find("],\"displayTimeUnit\":\"ns\"}") != std::string::npos);
+
+    SECTION("The event limit caps a capture") {
+        tracing::start_capture(5);
+        for (int i = 0; i < 20; ++i) traced_work(10);
+        tracing::stop_capture();
+        std::ostringstream limited;
+        CHECK(tracing::write_chrome_trace(limited) == 5);
+    }
+}
@@ -0,0 +1,70 @@
+// tests/url_batch_test.cpp
+#include <catch2/catch_test_macros.hpp>
+#include <seedlib/url_batch.hpp>
+
+using namespace seedlib;
+
+TEST_CASE("Batch parsing fills columns per row", "[url][batch]") {
+    const std::vector<std::string_view> urls = {
+        "https://example.com:8443/a?x=1#f",
+        "not a url",
+        "ws://socket.example.org/chat",
+    };
+
+    auto batch = parse_batch(urls);
+    REQUIRE(batch.size() == 3);
+    CHECK(batch.valid_count() == 2);
+
+    SECTION("Valid rows expose their components") {
+        CHECK(batch.valid(0));
+        CHECK(batch.scheme_ids()[0] == SchemeId::https);
+        CHECK(batch.ports()[0] == 8443);
+        CHECK(batch.host(0) == "example.com");
+        CHECK(batch.path(0) == "/a");
+
+        CHECK(batch.scheme_ids()[2] == SchemeId::ws);
+        CHECK(batch.ports()[2] == 80);
+        CHECK(batch.view(2).host() == "socket.example.org");
+    }
+
+    SECTION("Invalid rows record the error") {
+        CHECK_FALSE(batch.valid(1));
+        CHECK(batch.error(1) == URLErrc::invalid_format);
+        CHECK(batch.hosts()[1].length == 0);
+    }
+}
+
+TEST_CASE("Batch storage is reused across calls", "[url][batch]") {
+    std::vector<std::string_view> urls(100, "http://example.com/");
+    URLBatch batch;
+    parse_batch(urls, batch);
+    const auto* hosts = batch.hosts().data();
+
+    urls.resize(70, "http://example.com/");
+    urls[69] = "bad";
+    parse_batch(urls, batch);
+    CHECK(batch.size() == 70);
+    CHECK(batch.valid_count() == 69);
+    CHECK(batch.hosts().data() == hosts);
+}
+
+TEST_CASE("Parallel batch parsing matches serial results", "[url][batch]") {
+    std::vector<std::string> storage;
+    for (int i = 0; i < 5000; ++i) {
+        storage.push_back(i % 7 == 0 ? "bad url " + std::to_string(i)
+                                     : "https://host" + std::to_string(i) + ".example/p");
+    }
+    std::vector<std::string_view> urls(storage.begin(), storage.end());
+
+    URLBatch serial;
+    URLBatch parallel;
+    parse_batch(urls, serial);
+    parse_batch(urls, parallel, 4);
+
+    REQUIRE(parallel.size() == serial.size());
+    CHECK(parallel.valid_count() == serial.valid_count());
+    CHECK(parallel.valid_bits() == serial.valid_bits());
+    for (size_t i = 0; i < urls.size(); ++i) {
+        REQUIRE(parallel.host(i) == serial.host(i));
+    }
+}
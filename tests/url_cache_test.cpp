@@ -0,0 +1,73 @@
+// tests/url_cache_test.cpp
+#include <catch2/catch_test_macros.hpp>
+#include <seedlib/url_cache.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace seedlib;
+
+TEST_CASE("URL cache memoizes parses", "[cache]") {
+    URLCache cache(64, 4);
+
+    SECTION("Hits return the same shared URL") {
+        auto first = cache.parse("https://example.com/a");
+        REQUIRE(first);
+        CHECK(first->host() == "example.com");
+
+        auto second = cache.parse(std::string("https://example.com/a"));
+        CHECK(second.get() == first.get());
+
+        auto stats = cache.stats();
+        CHECK(stats.hits == 1);
+        CHECK(stats.misses == 1);
+        CHECK(stats.size == 1);
+    }
+
+    SECTION("Invalid input is rejected and not cached") {
+        CHECK_FALSE(cache.parse("not a url"));
+        CHECK_FALSE(cache.parse("not a url"));
+        CHECK(cache.stats().rejected == 2);
+        CHECK(cache.stats().size == 0);
+    }
+
+    SECTION("find does not parse") {
+        CHECK_FALSE(cache.find("http://a.example/"));
+        cache.parse("http://a.example/");
+        CHECK(cache.find("http://a.example/"));
+    }
+
+    SECTION("Size stays bounded and hot entries survive") {
+        auto hot = cache.parse("http://hot.example/");
+        for (int i = 0; i < 1000; ++i) {
+            cache.parse("http://cold" + std::to_string(i) + ".example/");
+            cache.parse("http://hot.example/");
+        }
+        auto stats = cache.stats();
+        CHECK(stats.size <= 64);
+        CHECK(stats.evictions > 0);
+        CHECK(cache.find("http://hot.example/").get() == hot.get());
+
+        cache.clear();
+        CHECK(cache.stats().size == 0);
+        CHECK(hot->to_string() == "http://hot.example/");
+    }
+
+    SECTION("Concurrent parses agree") {
+        std::vector<std::thread> threads;
+        std::atomic<int> wrong{0};
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 500; ++i) {
+                    const std::string host = "h" + std::to_string(i % 50) + ".example";
+                    auto url = cache.parse("http://" + host + "/");
+                    if (!url || url->host() != host) ++wrong;
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        CHECK(wrong == 0);
+        CHECK(cache.stats().hits + cache.stats().misses == 2000);
+    }
+}
@@ -0,0 +1,126 @@
+// tests/url_matcher_test.cpp
+#include <catch2/catch_test_macros.hpp>
+#include <seedlib/url.hpp>
+#include <seedlib/url_matcher.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace seedlib;
+
+namespace {
+    using Ids = std::vector<uint32_t>;
+
+    Ids match(const URLMatcher& matcher, std::string_view url) {
+        const auto view = URLView::parse(url);
+        REQUIRE(view);
+        return matcher.match(*view);
+    }
+}
+
+TEST_CASE("Host patterns match names, subdomains and any host", "[matcher]") {
+    URLRuleSet rules;
+    rules.add("example.com", 1);
+    rules.add("*.example.com", 2);
+    rules.add("*", 3);
+    rules.add("www.example.org", 4);
+    const URLMatcher matcher(rules);
+    CHECK(matcher.size() == 4);
+
+    CHECK(match(matcher, "https://example.com/") == Ids{1, 3});
+    CHECK(match(matcher, "https://api.example.com/x") == Ids{2, 3});
+    CHECK(match(matcher, "https://a.b.example.com/x") == Ids{2, 3});
+    CHECK(match(matcher, "https://WWW.Example.ORG/") == Ids{3, 4});
+    CHECK(match(matcher, "https://example.com./") == Ids{1, 3});
+    CHECK(match(matcher, "https://badexample.com/") == Ids{3});
+    CHECK(match(matcher, "https://example.org/") == Ids{3});
+}
+
+TEST_CASE("Path patterns match exactly or everything below a prefix", "[matcher]") {
+    URLRuleSet rules;
+    rules.add("example.com/api/v2/*", 1);
+    rules.add("example.com/api/v2/users/list", 2);  // Collapsed into one edge below /api/v2
+    rules.add("example.com/", 3);
+    rules.add("example.com/*", 4);
+    rules.add("example.com/static/app.js", 5);
+    const URLMatcher matcher(rules);
+
+    CHECK(match(matcher, "http://example.com/api/v2") == Ids{1, 4});
+    CHECK(match(matcher, "http://example.com/api/v2/") == Ids{1, 4});
+    CHECK(match(matcher, "http://example.com/api/v2/users/list") == Ids{1, 2, 4});
+    CHECK(match(matcher, "http://example.com/api/v2/users/list/more") == Ids{1, 4});
+    CHECK(match(matcher, "http://example.com/api/v2/users") == Ids{1, 4});
+    CHECK(match(matcher, "http://example.com/api/v2x") == Ids{4});
+    CHECK(match(matcher, "http://example.com/api") == Ids{4});
+    CHECK(match(matcher, "http://example.com") == Ids{3, 4});
+    CHECK(match(matcher, "http://example.com/?q=1") == Ids{3, 4});
+    CHECK(match(matcher, "http://example.com/static/app.js") == Ids{4, 5});
+    CHECK(match(matcher, "http://example.com/static/app.jsx") == Ids{4});
+}
+
+TEST_CASE("Schemes and shared ids filter and merge matches", "[matcher]") {
+    URLRuleSet rules;
+    rules.add("https://*.example.com/*", 7);
+    rules.add("example.net/login", 7);
+    rules.add("ws://socket.example.com", 8);
+    const URLMatcher matcher(rules);
+
+    CHECK(match(matcher, "https://a.example.com/") == Ids{7});
+    CHECK(match(matcher, "http://a.example.com/").empty());
+    CHECK(match(matcher, "ftp://example.net/login") == Ids{7});
+    CHECK(match(matcher, "ws://socket.example.com/chat") == Ids{8});
+    CHECK(match(matcher, "wss://socket.example.com/chat").empty());
+
+    const URL owned = URL::parse("https://socket.example.com/x").value();
+    CHECK(matcher.match(owned) == Ids{7});
+
+    SECTION("A reused output vector is cleared") {
+        std::vector<uint32_t> out = {1, 2, 3};
+        matcher.match(*URLView::parse("http://nothing.example/"), out);
+        CHECK(out.empty());
+    }
+}
+
+TEST_CASE("Malformed patterns are rejected", "[matcher]") {
+    URLRuleSet rules;
+    CHECK_THROWS_AS(rules.add("", 1), std::invalid_argument);
+    CHECK_THROWS_AS(rules.add("/path/only", 1), std::invalid_argument);
+    CHECK_THROWS_AS(rules.add("gopher://example.com", 1), std::invalid_argument);
+    CHECK_THROWS_AS(rules.add("a.*.example.com", 1), std::invalid_argument);
+    CHECK_THROWS_AS(rules.add("example..com", 1), std::invalid_argument);
+    CHECK_THROWS_AS(rules.add("example.com/*/users", 1), std::invalid_argument);
+    CHECK_THROWS_AS(rules.add("example.com:8080/", 1), std::invalid_argument);
+    CHECK(rules.empty());
+}
+
+TEST_CASE("Rule sets reload while other threads match", "[matcher]") {
+    URLRuleSet first;
+    first.add("*.example.com/*", 1);
+    URLRuleSet second;
+    second.add("*.example.com/*", 2);
+    second.add("*.example.com/api/*", 3);
+
+    URLMatcher matcher(first);
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> inconsistent{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            const auto view = URLView::parse("https://a.example.com/api/v1");
+            std::vector<uint32_t> ids;
+            while (!stop.load()) {
+                matcher.match(*view, ids);
+                if (ids != Ids{1} && ids != Ids{2, 3}) inconsistent.fetch_add(1);
+            }
+        });
+    }
+    for (int i = 0; i < 200; ++i) matcher.reload(i % 2 == 0 ? second : first);
+    stop.store(true);
+    for (auto& reader : readers) reader.join();
+
+    CHECK(inconsistent.load() == 0);
+    CHECK(matcher.size() == 1);
+    CHECK(match(matcher, "https://b.example.com/api/x") == Ids{1});
+}
@@ -0,0 +1,123 @@
+// tests/url_store_test.cpp
+#include <catch2/catch_test_macros.hpp>
+#include <seedlib/url_batch.hpp>
+#include <seedlib/url_store.hpp>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace seedlib;
+
+namespace {
+    constexpr int kPending = 0;
+    constexpr int kFetched = 1;
+
+    std::vector<std::string> paths_of(const std::vector<StoredURL>& rows) {
+        std::vector<std::string> paths;
+        for (const auto& row : rows) paths.push_back(row.path);
+        return paths;
+    }
+}
+
+TEST_CASE("Batches are stored as decomposed columns", "[store]") {
+    URLStore store(":memory:");
+    const std::vector<std::string_view> urls = {
+        "https://Example.com:8443/b?x=1#frag",
+        "not a url",
+        "http://example.com/a",
+        "ws://socket.example.org/chat",
+        "http://EXAMPLE.com/a",  // Same URL once the host is lowercased
+    };
+    const URLBatch batch = parse_batch(urls);
+
+    CHECK(store.insert(batch) == 3);
+    CHECK(store.size() == 3);
+
+    SECTION("Columns round-trip") {
+        const auto rows = store.find({"example.com"});
+        REQUIRE(rows.size() == 2);
+        CHECK(rows[0].scheme_id == SchemeId::http);
+        CHECK(rows[0].scheme == "http");
+        CHECK(rows[0].host == "example.com");
+        CHECK(rows[0].path == "/a");
+        CHECK(rows[0].query.empty());
+        CHECK(rows[0].href() == "http://example.com/a");
+
+        CHECK(rows[1].scheme_id == SchemeId::https);
+        CHECK(rows[1].port == 8443);
+        CHECK(rows[1].query == "x=1");
+        CHECK(rows[1].href() == "https://example.com:8443/b?x=1");
+    }
+
+    SECTION("Host lookups fold case and miss unknown hosts") {
+        CHECK(store.find({"EXAMPLE.COM"}).size() == 2);
+        CHECK(store.find({"socket.example.org"}).front().href() == "ws://socket.example.org/chat");
+        CHECK(store.find({"nowhere.example"}).empty());
+        CHECK(store.find({}).size() == 3);
+    }
+
+    SECTION("Reinserting stores nothing new") {
+        CHECK(store.insert(batch) == 0);
+        CHECK_FALSE(store.insert(batch.view(2)));
+        CHECK(store.size() == 3);
+    }
+}
+
+TEST_CASE("Path prefixes select a range of a host's paths", "[store]") {
+    URLStore store(":memory:");
+    const std::vector<std::string_view> urls = {
+        "http://shop.example/api/v1/users", "http://shop.example/api/v2/orders", "http://shop.example/apix",
+        "http://shop.example/api",          "http://shop.example/b",             "http://other.example/api/v1/users",
+    };
+    store.insert(parse_batch(urls));
+
+    CHECK(paths_of(store.find({"shop.example", "/api/"})) ==
+          std::vector<std::string>{"/api/v1/users", "/api/v2/orders"});
+    CHECK(paths_of(store.find({"shop.example", "/api"})) ==
+          std::vector<std::string>{"/api", "/api/v1/users", "/api/v2/orders", "/apix"});
+    CHECK(store.find({"shop.example", "/API"}).empty());
+    CHECK(store.find({"", "/api/v1/"}).size() == 2);
+    CHECK(store.find({"shop.example", "/", -1, 2}).size() == 2);
+}
+
+TEST_CASE("Statuses filter lookups and can be updated", "[store]") {
+    URLStore store(":memory:");
+    store.insert(parse_batch({"http://crawl.example/1", "http://crawl.example/2", "http://crawl.example/3"}), kPending);
+
+    auto pending = store.find({"crawl.example", {}, kPending});
+    REQUIRE(pending.size() == 3);
+    CHECK(store.set_status(pending[1].id, kFetched));
+    CHECK_FALSE(store.set_status(pending.back().id + 100, kFetched));
+
+    CHECK(paths_of(store.find({"crawl.example", {}, kPending})) == std::vector<std::string>{"/1", "/3"});
+    CHECK(paths_of(store.find({"crawl.example", {}, kFetched})) == std::vector<std::string>{"/2"});
+}
+
+TEST_CASE("File stores use WAL and persist across connections", "[store]") {
+    const auto path = std::filesystem::temp_directory_path() / "seedlib_url_store_test.db";
+    std::filesystem::remove(path);
+    std::filesystem::remove(path.string() + "-wal");
+    std::filesystem::remove(path.string() + "-shm");
+
+    std::vector<std::string> owned;
+    for (int i = 0; i < 1000; ++i) {
+        owned.push_back("https://host" + std::to_string(i % 10) + ".example/p/" + std::to_string(i));
+    }
+    const std::vector<std::string_view> urls(owned.begin(), owned.end());
+
+    {
+        URLStoreOptions options;
+        options.rows_per_transaction = 64;  // Several commits for one batch
+        URLStore store(path.string(), options);
+        CHECK(store.insert(parse_batch(urls)) == 1000);
+        CHECK(std::filesystem::exists(path.string() + "-wal"));
+
+        URLStore reader(path.string());
+        CHECK(reader.find({"host3.example", "/p/"}).size() == 100);
+    }
+
+    URLStore reopened(path.string());
+    CHECK(reopened.size() == 1000);
+    CHECK(paths_of(reopened.find({"host7.example", "/p/99"})) == std::vector<std::string>{"/p/997"});
+    std::filesystem::remove(path);
+}
@@ -1,10 +1,70 @@
 // tests/url_test.cpp
 #include <catch2/catch_test_macros.hpp>
 #include <seedlib/url.hpp>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace seedlib;
 
+namespace {
+    std::atomic<size_t> heap_allocations{0};
+
+    void* counted_alloc(size_t size, size_t alignment) noexcept {
+        heap_allocations.fetch_add(1, std::memory_order_relaxed);
+        if (size == 0) size = 1;
+        return alignment <= alignof(std::max_align_t)
+                   ? std::malloc(size)
+                   : std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+    }
+
+    void* counted_or_throw(size_t size, size_t alignment) {
+        if (void* p = counted_alloc(size, alignment)) return p;
+        throw std::bad_alloc();
+    }
+}
+
+// Every heap allocation in the test binary is counted. Each form is
+// replaced, not only the two that libstdc++ routes the others through:
+// under ASan the runtime's own forms would run, and memory it allocated
+// would reach the free() below (or the other way round).
+void* operator new(size_t size) { return counted_or_throw(size, 0); }
+void* operator new[](size_t size) { return counted_or_throw(size, 0); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size, 0); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return counted_alloc(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment) {
+    return counted_or_throw(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return counted_or_throw(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return counted_alloc(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return counted_alloc(size, static_cast<size_t>(alignment));
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
 TEST_CASE("URL parsing basic functionality", "[url]") {
     SECTION("Valid URLs are parsed correctly") {
         auto url = URL::parse("https://example.com:8080/path?query#fragment");
@@ -40,6 +100,201 @@ TEST_CASE("URL validation provides meaningful errors", "[url]") {
     }
 }
 
+TEST_CASE("URL scanner handles component boundaries", "[url]") {
+    SECTION("Userinfo is skipped and default ports apply") {
+        auto url = URL::parse("HTTP://user:pa:ss@example.com/a?b");
+        REQUIRE(url.has_value());
+        CHECK(url->scheme() == "http");
+        CHECK(url->host() == "example.com");
+        CHECK(url->port() == 80);
+        CHECK(url->path() == "/a");
+        CHECK(url->query() == "b");
+    }
+
+    SECTION("Bracketed IPv6 hosts keep their colons") {
+        auto url = URL::parse("http://[::1]:8080");
+        REQUIRE(url.has_value());
+        CHECK(url->host() == "[::1]");
+        CHECK(url->port() == 8080);
+        CHECK(url->path() == "/");
+    }
+
+    SECTION("Query and fragment delimiters are found in order") {
+        auto url = URL::parse("https://example.com#frag?not-query");
+        REQUIRE(url.has_value());
+        CHECK(url->query().empty());
+        CHECK(url->fragment() == "frag?not-query");
+    }
+
+    SECTION("Port errors are reported") {
+        CHECK(URL::validate("http://example.com:99999").reason == "Port number out of range");
+        CHECK(URL::validate("http://example.com:80a").reason == "Invalid port number");
+        CHECK(URL::validate("1http://example.com").reason == "Invalid scheme");
+    }
+}
+
+TEST_CASE("URL scanner finds delimiters in long components", "[url]") {
+    // Walk the delimiter across vector-width boundaries
+    for (size_t length = 0; length < 100; ++length) {
+        std::string path(length, 'p');
+        auto url = URL::parse("https://example.com/" + path + "?q" + path + "#f");
+        REQUIRE(url.has_value());
+        CHECK(url->path().size() == length + 1);
+        CHECK(url->query().size() == length + 1);
+        CHECK(url->fragment() == "f");
+    }
+}
+
+TEST_CASE("URLView parses without owning", "[url][view]") {
+    const std::string input = "HTTPS://example.com/path?q=1#top";
+
+    SECTION("Components point into the caller's buffer") {
+        auto view = URLView::parse(input);
+        REQUIRE(view.has_value());
+        CHECK(view->scheme() == "HTTPS");
+        CHECK(view->host() == "example.com");
+        CHECK(view->host().data() == input.data() + 8);
+        CHECK(view->port() == 443);
+        CHECK(view->path() == "/path");
+        CHECK(view->query() == "q=1");
+        CHECK(view->fragment() == "top");
+    }
+
+    SECTION("to_owned matches URL::parse") {
+        auto owned = URLView::parse(input)->to_owned();
+        CHECK(owned.scheme() == "https");
+        CHECK(owned.to_string() == URL::parse(input)->to_string());
+    }
+
+    SECTION("Invalid input yields no view") {
+        CHECK_FALSE(URLView::parse("http://").has_value());
+    }
+}
+
+// tests/CMakeLists.txt also runs this case alone, so that its parse is the
+// first one in the process
+TEST_CASE("URLView parsing allocates at most the thread's metrics block", "[url][view]") {
+    // A thread's first metric update of any kind attaches its metrics
+    // block, reusing one an exited thread left when it can; parses after
+    // that allocate nothing
+    bool parsed = false;
+    bool rejected = false;
+    size_t first = 0;
+    size_t later = 0;
+    std::thread([&] {
+        URLError error;
+        size_t before = heap_allocations.load();
+        parsed = URLView::parse("https://example.com:8443/a/b?q=1#top").has_value();
+        first = heap_allocations.load() - before;
+
+        before = heap_allocations.load();
+        rejected = !URLView::try_parse("http://example.com:99999/", error);
+        parsed = parsed && URLView::parse("https://example.org/").has_value();
+        later = heap_allocations.load() - before;
+    }).join();
+
+    REQUIRE(parsed);
+    CHECK(rejected);
+    CHECK(first <= 1);
+    CHECK(later == 0);
+}
+
+TEST_CASE("URL try_parse reports errors without throwing", "[url]") {
+    URLError error;
+
+    SECTION("Success clears the error") {
+        error.code = URLErrc::invalid_host;
+        CHECK(URL::try_parse("https://example.com", error).has_value());
+        CHECK_FALSE(error);
+    }
+
+    SECTION("Failures carry a code and byte offset") {
+        CHECK_FALSE(URL::try_parse("http://exa mple.com", error).has_value());
+        CHECK(error.code == URLErrc::invalid_host);
+        CHECK(error.offset == 10);
+
+        CHECK_FALSE(URL::try_parse("http://example.com:8x", error).has_value());
+        CHECK(error.code == URLErrc::invalid_port);
+        CHECK(error.offset == 20);
+
+        CHECK_FALSE(URL::try_parse("not a url", error).has_value());
+        CHECK(error.code == URLErrc::invalid_format);
+        CHECK(std::string(error.message()) == "Invalid URL format");
+    }
+}
+
+TEST_CASE("URL query parameters are iterated lazily", "[url][query]") {
+    auto url = URL::parse("https://example.com/s?q=red+shoes&page=2&&tag=a&tag=b&flag&caf%C3%A9=1").value();
+    auto params = url.query_params();
+
+    SECTION("Pairs keep order and duplicates") {
+        std::vector<std::pair<std::string_view, std::string_view>> seen;
+        for (const auto& param : params) {
+            seen.emplace_back(param.key, param.value);
+        }
+        REQUIRE(seen.size() == 6);
+        CHECK(seen[0].first == "q");
+        CHECK(seen[0].second == "red+shoes");
+        CHECK(seen[2].second == "a");
+        CHECK(seen[3].second == "b");
+        CHECK(seen[4].first == "flag");
+        CHECK(seen[4].second.empty());
+    }
+
+    SECTION("find stops at the first decoded match") {
+        auto tag = params.find("tag");
+        REQUIRE(tag.has_value());
+        CHECK(tag->value == "a");
+        CHECK(params.find("q")->decoded_value() == "red shoes");
+        CHECK(params.find("caf\xc3\xa9")->value == "1");
+        CHECK_FALSE(params.find("missing").has_value());
+    }
+
+    SECTION("Decoding keeps malformed escapes and decodes around them") {
+        const QueryParam param{"k%2", "a+b%2"};
+        CHECK(param.decoded_key() == "k%2");
+        CHECK(param.decoded_value() == "a b%2");
+    }
+
+    SECTION("Empty queries yield nothing") {
+        CHECK(URL::parse("https://example.com/").value().query_params().empty());
+    }
+}
+
+struct TestSchemes;
+
+template <>
+struct seedlib::scheme_extension<TestSchemes> {
+    static constexpr SchemeInfo entries[] = {{"gopher", SchemeId::unknown, 70, false, false}};
+};
+
+TEST_CASE("Scheme registry resolves at compile time", "[url][scheme]") {
+    static_assert(lookup_scheme("HTTPS") == SchemeId::https);
+    static_assert(lookup_scheme("htt") == SchemeId::unknown);
+    static_assert(scheme_info(SchemeId::wss).secure);
+    static_assert(SchemeRegistry<TestSchemes>::default_port("Gopher") == 70);
+    static_assert(SchemeRegistry<TestSchemes>::default_port("ws") == 80);
+
+    SECTION("Parsed URLs carry the scheme id") {
+        auto url = URL::parse("WSS://example.com/chat").value();
+        CHECK(url.scheme_id() == SchemeId::wss);
+        CHECK(url.scheme() == "wss");
+        CHECK(url.is_secure());
+
+        auto custom = URL::parse("Git+SSH://example.com/repo").value();
+        CHECK(custom.scheme_id() == SchemeId::unknown);
+        CHECK(custom.scheme() == "git+ssh");
+        CHECK(custom.port() == 0);
+    }
+
+    SECTION("Switching between special schemes keeps the id in sync") {
+        auto url = URL::parse("http://example.com/").value();
+        url.set_scheme("WS");
+        CHECK(url.scheme_id() == SchemeId::ws);
+        CHECK(url.to_string() == "ws://example.com/");
+    }
+}
+
 TEST_CASE("URL golden value tests", "[url][golden]") {
     std::ifstream golden_file("tests/data/url_golden.json");
     REQUIRE(golden_file.is_open());
@@ -62,6 +317,17 @@ TEST_CASE("URL modification maintains validity", "[url]") {
         CHECK_THROWS_AS(url.set_scheme("not-a-scheme"), URLValidationError);
     }
 
+    SECTION("Copies are independent of the original") {
+        URL copy = url;
+        copy.set_scheme("https");
+        CHECK(url.scheme() == "http");
+        CHECK(copy.to_string() == "https://example.com:80/");
+
+        url = copy;
+        CHECK(url.scheme() == "https");
+        CHECK(url.host() == "example.com");
+    }
+
     SECTION("Setting valid port works") {
         url.set_port(8080);
         CHECK(url.port() == 8080);
@@ -74,6 +340,50 @@ TEST_CASE("URL modification maintains validity", "[url]") {
 }
 
 // Example of property-based testing
+TEST_CASE("URL component setters patch in place", "[url]") {
+    auto url = URL::parse("https://example.com/old?a=1#top").value();
+
+    SECTION("Each component can be replaced") {
+        url.set_host("cdn.example.org");
+        url.set_path("/assets/app.js");
+        url.set_query("v=2");
+        url.set_fragment("");
+        CHECK(url.to_string() == "https://cdn.example.org/assets/app.js?v=2");
+        CHECK(url.scheme() == "https");
+    }
+
+    SECTION("Values taken from the URL itself are safe") {
+        url.set_path(url.path().substr(0, 2));
+        url.set_host(url.host().substr(0, 7));
+        CHECK(url.to_string() == "https://example/o?a=1#top");
+    }
+
+    SECTION("Query parameters are appended encoded") {
+        url.append_query_param("q", "red shoes&more");
+        CHECK(url.query() == "a=1&q=red+shoes%26more");
+        CHECK(url.query_params().find("q")->decoded_value() == "red shoes&more");
+
+        url.set_query("");
+        url.append_query_param("x", "1");
+        CHECK(url.query() == "x=1");
+        CHECK(url.fragment() == "top");
+    }
+
+    SECTION("Invalid values throw") {
+        CHECK_THROWS_AS(url.set_host("bad host"), URLValidationError);
+        CHECK_THROWS_AS(url.set_host(""), URLValidationError);
+        CHECK_THROWS_AS(url.set_path("no-slash"), URLValidationError);
+        CHECK_THROWS_AS(url.set_path("/a?b"), URLValidationError);
+        CHECK_THROWS_AS(url.set_query("a#b"), URLValidationError);
+        CHECK(url.to_string() == "https://example.com/old?a=1#top");
+    }
+
+    SECTION("Empty path becomes root") {
+        url.set_path("");
+        CHECK(url.path() == "/");
+    }
+}
+
 TEST_CASE("URL properties", "[url][property]") {
     SECTION("Parsing and toString are inverse operations") {
         auto url = URL::parse("https://example.com/path").value();
@@ -81,4 +391,315 @@ TEST_CASE("URL properties", "[url][property]") {
         auto reparsed = URL::parse(str).value();
         CHECK(url.to_string() == reparsed.to_string());
     }
+
+    SECTION("Serialization forms agree") {
+        auto url = URL::parse("http://example.com:8080/a?b=c#d").value();
+        CHECK(url.to_string() == "http://example.com:8080/a?b=c#d");
+
+        std::string buffer = "GET ";
+        url.append_to(buffer);
+        CHECK(buffer == "GET " + url.to_string());
+
+        std::string formatted;
+        url.format_to(std::back_inserter(formatted));
+        CHECK(formatted == url.to_string());
+
+        CHECK(URL::parse("https://example.com:443/").value().to_string() == "https://example.com/");
+    }
+}
+
+TEST_CASE("URL normalization", "[url][normalize]") {
+    auto normalized = [](std::string_view text, NormalizeOptions options = {}) {
+        auto url = URL::parse(text).value();
+        url.normalize(options);
+        return url.to_string();
+    };
+
+    SECTION("Host case, default port and escapes") {
+        CHECK(normalized("HTTP://Example.COM:80/%7euser/%2f") == "http://example.com/~user/%2F");
+        CHECK(normalized("http://example.com") == "http://example.com/");
+        CHECK(normalized("http://example.com:8080/?q=%e2%82%ac") == "http://example.com:8080/?q=%E2%82%AC");
+    }
+
+    SECTION("Dot segments are removed") {
+        CHECK(normalized("http://a.com/a/b/c/./../../g") == "http://a.com/a/g");
+        CHECK(normalized("http://a.com/a/b/.") == "http://a.com/a/b/");
+        CHECK(normalized("http://a.com/a/b/..") == "http://a.com/a/");
+        CHECK(normalized("http://a.com/../../x") == "http://a.com/x");
+        CHECK(normalized("http://a.com/a/%2E%2e/b") == "http://a.com/b");
+        CHECK(normalized("http://a.com/a//b/...") == "http://a.com/a//b/...");
+    }
+
+    SECTION("Query sorting is opt-in and stable") {
+        CHECK(normalized("http://a.com/?b=2&a=1&b=1") == "http://a.com/?b=2&a=1&b=1");
+        NormalizeOptions sorted;
+        sorted.sort_query = true;
+        CHECK(normalized("http://a.com/?b=2&a=1&b=1&&%61=0", sorted) == "http://a.com/?a=1&a=0&b=2&b=1");
+        // An empty value keeps its '=': "a=" and "a" are different queries
+        CHECK(normalized("http://a.com/?a=&b=1", sorted) == "http://a.com/?a=&b=1");
+        CHECK(normalized("http://a.com/?b=1&a=", sorted) == "http://a.com/?a=&b=1");
+        CHECK(normalized("http://a.com/?b=1&a", sorted) == "http://a.com/?a&b=1");
+    }
+
+    SECTION("Canonical hash matches the normalized form") {
+        const auto a = URL::parse("HTTP://Example.COM:80/a/./b/../c?%7a#F").value();
+        const auto b = URL::parse("http://example.com/a/c?z#F").value();
+        CHECK(a.canonical_hash() == b.canonical_hash());
+        CHECK(a.canonical_hash() != URL::parse("http://example.com/a/c?z#f").value().canonical_hash());
+
+        auto copy = a;
+        copy.normalize();
+        CHECK(copy.to_string() == b.to_string());
+        CHECK(copy.canonical_hash() == a.canonical_hash());
+
+        NormalizeOptions sorted;
+        sorted.sort_query = true;
+        const auto c = URL::parse("http://a.com/?y=1&x=2").value();
+        const auto d = URL::parse("http://a.com/?x=2&y=1").value();
+        CHECK(c.canonical_hash() != d.canonical_hash());
+        CHECK(c.canonical_hash(sorted) == d.canonical_hash(sorted));
+        CHECK(URL::parse("http://a.com/?a=&b=1").value().canonical_hash(sorted) ==
+              URL::parse("http://a.com/?a=&b=1").value().canonical_hash());
+    }
+}
+
+namespace {
+    // Counts traffic through to the default resource
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        size_t allocations = 0;
+        size_t deallocations = 0;
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            ++deallocations;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+}
+
+TEST_CASE("URL storage from a memory resource", "[url][pmr]") {
+    SECTION("Parse, grow and destroy go through the resource") {
+        CountingResource resource;
+        {
+            auto url = URL::parse("https://example.com/a?b=c", &resource);
+            REQUIRE(url.has_value());
+            CHECK(resource.allocations == 1);
+            CHECK(url->to_string() == "https://example.com/a?b=c");
+
+            url->set_path("/" + std::string(200, 'x'));
+            CHECK(resource.allocations == 2);
+            CHECK(resource.deallocations == 1);
+
+            auto copy = *url;
+            CHECK(resource.allocations == 2);
+            CHECK(copy.to_string() == url->to_string());
+        }
+        CHECK(resource.deallocations == resource.allocations);
+    }
+
+    SECTION("Arena URLs are released together") {
+        char buffer[1024];
+        Arena arena(buffer, sizeof(buffer));
+        auto a = URL::parse("http://a.example/x", arena);
+        auto b = URL::parse("http://b.example/y", arena.resource());
+        REQUIRE(a.has_value());
+        REQUIRE(b.has_value());
+        CHECK(a->host().data() >= buffer);
+        CHECK(a->host().data() < buffer + sizeof(buffer));
+        CHECK(b->to_string() == "http://b.example/y");
+
+        URLError error;
+        CHECK_FALSE(URL::try_parse("not a url", error, arena.resource()).has_value());
+        CHECK(error.code == URLErrc::invalid_format);
+    }
+}
+
+TEST_CASE("Reference resolution", "[url][resolve]") {
+    // RFC 3986 5.4; expected targets are compared in their parsed form
+    const auto base = URL::parse("http://a/b/c/d;p?q").value();
+    auto check = [&base](std::string_view ref, std::string_view expected) {
+        INFO(ref);
+        auto resolved = base.resolve(ref);
+        REQUIRE(resolved.has_value());
+        CHECK(resolved->to_string() == URL::parse(expected).value().to_string());
+    };
+
+    SECTION("Normal examples") {
+        check("g:h", "g:h");
+        check("g", "http://a/b/c/g");
+        check("./g", "http://a/b/c/g");
+        check("g/", "http://a/b/c/g/");
+        check("/g", "http://a/g");
+        check("//g", "http://g");
+        check("?y", "http://a/b/c/d;p?y");
+        check("g?y", "http://a/b/c/g?y");
+        check("#s", "http://a/b/c/d;p?q#s");
+        check("g#s", "http://a/b/c/g#s");
+        check("g?y#s", "http://a/b/c/g?y#s");
+        check(";x", "http://a/b/c/;x");
+        check("g;x", "http://a/b/c/g;x");
+        check("g;x?y#s", "http://a/b/c/g;x?y#s");
+        check("", "http://a/b/c/d;p?q");
+        check(".", "http://a/b/c/");
+        check("./", "http://a/b/c/");
+        check("..", "http://a/b/");
+        check("../", "http://a/b/");
+        check("../g", "http://a/b/g");
+        check("../..", "http://a/");
+        check("../../", "http://a/");
+        check("../../g", "http://a/g");
+    }
+
+    SECTION("Abnormal examples") {
+        check("../../../g", "http://a/g");
+        check("../../../../g", "http://a/g");
+        check("/./g", "http://a/g");
+        check("/../g", "http://a/g");
+        check("g.", "http://a/b/c/g.");
+        check(".g", "http://a/b/c/.g");
+        check("g..", "http://a/b/c/g..");
+        check("..g", "http://a/b/c/..g");
+        check("./../g", "http://a/b/g");
+        check("./g/.", "http://a/b/c/g/");
+        check("g/./h", "http://a/b/c/g/h");
+        check("g/../h", "http://a/b/c/h");
+        check("g;x=1/./y", "http://a/b/c/g;x=1/y");
+        check("g;x=1/../y", "http://a/b/c/y");
+        check("g?y/./x", "http://a/b/c/g?y/./x");
+        check("g?y/../x", "http://a/b/c/g?y/../x");
+        check("g#s/./x", "http://a/b/c/g#s/./x");
+        check("g#s/../x", "http://a/b/c/g#s/../x");
+        check("http:g", "http:g");
+    }
+
+    SECTION("Ports, long targets and failures") {
+        const auto ported = URL::parse("https://example.com:8443/dir/page").value();
+        CHECK(ported.resolve("other?x=1")->to_string() == "https://example.com:8443/dir/other?x=1");
+
+        const std::string long_ref = "/" + std::string(4000, 'p');
+        CHECK(base.resolve(long_ref)->path() == long_ref);
+
+        URLError error;
+        CHECK_FALSE(base.try_resolve("//exa mple.com/", error).has_value());
+        CHECK(error.code == URLErrc::invalid_host);
+    }
+
+    SECTION("Batch resolution matches one at a time") {
+        const std::vector<std::string_view> refs = {"g", "../x", "//h/p", "bad url://"};
+        const auto results = base.resolve(refs);
+        REQUIRE(results.size() == refs.size());
+        for (size_t i = 0; i < refs.size(); ++i) {
+            auto single = base.resolve(refs[i]);
+            REQUIRE(results[i].has_value() == single.has_value());
+            if (single) CHECK(results[i]->to_string() == single->to_string());
+        }
+    }
+}
+
+TEST_CASE("Validation profiles", "[url][validate]") {
+    SECTION("Strict RFC 3986 checks every component") {
+        CHECK_FALSE(URL::check("https://user:pw@example.com:8080/a/b;c?q=1&r=%2F#top"));
+        CHECK_FALSE(URL::check("urn:isbn:0451450523"));
+        CHECK_FALSE(URL::check("http://[::ffff:192.0.2.1]/"));
+        CHECK_FALSE(URL::check("file:///etc/hosts"));
+
+        CHECK(URL::check("http://example.com/a b").code == URLErrc::invalid_path);
+        CHECK(URL::check("http://example.com/a b").offset == 20);
+        CHECK(URL::check("http://example.com/?q=\"x\"").code == URLErrc::invalid_query);
+        CHECK(URL::check("http://example.com/#a#b").code == URLErrc::invalid_fragment);
+        CHECK(URL::check("http://example.com/%zz").code == URLErrc::invalid_percent_encoding);
+        CHECK(URL::check("http://example.com/%2").code == URLErrc::invalid_percent_encoding);
+        CHECK(URL::check("http://us er@example.com/").code == URLErrc::invalid_userinfo);
+        CHECK(URL::check("http://exa_mple!.com/").code == URLErrc::ok);
+        CHECK(URL::check("http://exa<mple.com/").code == URLErrc::invalid_host);
+        CHECK(URL::check("http://[v7.fe80::1]/").code == URLErrc::invalid_host);
+        CHECK(URL::check("http:///path").code == URLErrc::invalid_authority);
+    }
+
+    SECTION("Strict failures keep the parser's codes") {
+        for (const char* url : {"http://example.com:99999", "http://example.com:80a",
+                                "1http://example.com", "not a url", "http://[::1", "://x"}) {
+            URLError parse_error;
+            URL::try_parse(url, parse_error);
+            const URLError check_error = URL::check(url);
+            CHECK(check_error.code == parse_error.code);
+            CHECK(check_error.offset == parse_error.offset);
+        }
+    }
+
+    SECTION("Long components find the first failure at any offset") {
+        // Plain walk of the same rules for a query of [a-z0-9=&/._] and escapes
+        auto expected = [](const std::string& query) {
+            auto hex = [](char c) { return std::isxdigit(static_cast<unsigned char>(c)) != 0; };
+            for (size_t i = 0; i < query.size(); ++i) {
+                const char c = query[i];
+                if (std::isalnum(static_cast<unsigned char>(c)) || std::strchr("=&/._", c)) continue;
+                if (c != '%') return URLError{URLErrc::invalid_query, static_cast<uint32_t>(i)};
+                if (i + 2 >= query.size() || !hex(query[i + 1]) || !hex(query[i + 2])) {
+                    return URLError{URLErrc::invalid_percent_encoding, static_cast<uint32_t>(i)};
+                }
+                i += 2;
+            }
+            return URLError{};
+        };
+        const std::string prefix = "http://example.com/p?";
+        const std::string query = "q=%E6%97%A5%E6%9C%AC&redirect=https%3A%2F%2Fexample.com%2Fcb&utm_term=abc%2"
+                                  "0def&n=0123456789";
+
+        for (size_t length = 0; length <= query.size(); ++length) {
+            const std::string cut = query.substr(0, length);
+            for (size_t at = 0; at <= cut.size(); ++at) {
+                for (char bad : {' ', '%', '"'}) {
+                    std::string mutated = cut;
+                    if (at < cut.size()) mutated[at] = bad;
+                    const URLError want = expected(mutated);
+                    const URLError got = URL::check(prefix + mutated);
+                    if (got.code != want.code || (want && got.offset != prefix.size() + want.offset)) {
+                        FAIL_CHECK(mutated << ": code " << static_cast<int>(got.code) << " at " << got.offset);
+                    }
+                }
+            }
+        }
+        CHECK(URL::check("http://example.com/" + std::string(200, 'a') + "%4").offset == 219);
+        CHECK(URL::check("http://example.com/" + std::string(100, 'a') + "%41" + std::string(60, 'b') + "<").offset ==
+              182);
+    }
+
+    SECTION("Anything strictly valid parses") {
+        for (const char* url : {"https://example.com/", "mailto:user@example.com", "ftp://[::1]:21/x",
+                                "http://a/b/c/d;p?q", "h://", "file://"}) {
+            if (!URL::check(url)) CHECK(URL::parse(url).has_value());
+        }
+    }
+
+    SECTION("WHATWG profile fails only where the WHATWG parser does") {
+        const auto whatwg = ValidationProfile::whatwg;
+        CHECK_FALSE(URL::check("  https://example.com/a b?c=\"d\"#e#f ", whatwg));
+        CHECK_FALSE(URL::check("http:\\\\example.com\\path", whatwg));
+        CHECK_FALSE(URL::check("http:example.com", whatwg));
+        CHECK_FALSE(URL::check("http://0x7f.1/", whatwg));
+        CHECK_FALSE(URL::check("foo://", whatwg));
+        CHECK_FALSE(URL::check("http://example.com/%zz", whatwg));
+
+        CHECK(URL::check("http://", whatwg).code == URLErrc::invalid_authority);
+        CHECK(URL::check("http://exa mple.com/", whatwg).code == URLErrc::invalid_host);
+        CHECK(URL::check("http://256.0.0.1/", whatwg).code == URLErrc::invalid_host);
+        CHECK(URL::check("http://1.2.3.09/", whatwg).code == URLErrc::invalid_host);
+        CHECK(URL::check("http://user@/", whatwg).code == URLErrc::invalid_host);
+        CHECK(URL::check("http://example.com:65536/", whatwg).code == URLErrc::port_out_of_range);
+        CHECK(URL::check("example.com", whatwg).code == URLErrc::invalid_format);
+    }
+
+    SECTION("validate() reports the profile's reason") {
+        CHECK(URL::validate("http://example.com/a b").reason == "Invalid character in path");
+        CHECK(URL::validate("http://example.com/a b", ValidationProfile::whatwg).valid);
+    }
 }